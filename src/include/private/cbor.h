@@ -0,0 +1,129 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Declares the CBOR (RFC 8949) encoding primitives.
+  */
+
+ #pragma once
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/value.h>
+ #include <ostream>
+ #include <cstdint>
+ #include <cstring>
+
+ namespace Udjat {
+
+	namespace CBOR {
+
+		/// @brief Major types.
+		enum Major : uint8_t {
+			Positive	= 0,
+			Negative	= 1,
+			Bytes		= 2,
+			Text		= 3,
+			Array		= 4,
+			Map			= 5,
+			Tag			= 6,
+			Simple		= 7,
+		};
+
+		/// @brief Tag for the value types without a CBOR equivalent.
+		/// @details Standard tags are used when available (1 for timestamps, 32 for URLs);
+		/// the others are 'ud' followed by the Value::Type code, on the first come first served range.
+		constexpr uint64_t UdjatTag(const Value::Type type) {
+			return 0x756400 | ((uint64_t) type);
+		}
+
+		/// @brief Write the initial byte and the argument of a data item.
+		inline void head(std::ostream &out, const Major major, uint64_t value) {
+
+			uint8_t buffer[9];
+			size_t length;
+
+			buffer[0] = (major << 5);
+
+			if(value < 24) {
+				buffer[0] |= (uint8_t) value;
+				length = 1;
+			} else if(value <= 0xFF) {
+				buffer[0] |= 24;
+				length = 2;
+			} else if(value <= 0xFFFF) {
+				buffer[0] |= 25;
+				length = 3;
+			} else if(value <= 0xFFFFFFFF) {
+				buffer[0] |= 26;
+				length = 5;
+			} else {
+				buffer[0] |= 27;
+				length = 9;
+			}
+
+			// Network byte order.
+			for(size_t ix = length-1; ix > 0; ix--) {
+				buffer[ix] = (uint8_t) (value & 0xFF);
+				value >>= 8;
+			}
+
+			out.write((const char *) buffer,length);
+
+		}
+
+		inline void null(std::ostream &out) {
+			out.put((char) 0xF6);
+		}
+
+		inline void boolean(std::ostream &out, bool value) {
+			out.put((char) (value ? 0xF5 : 0xF4));
+		}
+
+		inline void text(std::ostream &out, const char *str) {
+			size_t length = strlen(str);
+			head(out,Text,length);
+			out.write(str,length);
+		}
+
+		inline void real(std::ostream &out, double value) {
+			uint64_t bits;
+			memcpy(&bits,&value,sizeof(bits));
+			out.put((char) 0xFB);
+			for(int shift = 56; shift >= 0; shift -= 8) {
+				out.put((char) ((bits >> shift) & 0xFF));
+			}
+		}
+
+		/// @brief Write integer.
+		/// @param is_signed True if the value type is Value::Signed, tags non negative values to keep the type.
+		inline void integer(std::ostream &out, long long value, bool is_signed) {
+			if(value < 0) {
+				head(out,Negative,(uint64_t) (-1 - value));
+				return;
+			}
+			if(is_signed) {
+				head(out,Tag,UdjatTag(Value::Signed));
+			}
+			head(out,Positive,(uint64_t) value);
+		}
+
+	}
+
+ }
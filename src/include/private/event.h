@@ -24,6 +24,13 @@
  #include <udjat/tools/event.h>
  #include <forward_list>
 
+ #ifndef _WIN32
+	#include <udjat/tools/mainloop.h>
+	#include <signal.h>
+	#include <thread>
+	#include <atomic>
+ #endif // _WIN32
+
  namespace Udjat {
 
 	class Event::Controller {
@@ -62,10 +69,52 @@
 
 		};
 
+		/// @brief Read the managed signals from a signalfd on a dedicated thread.
+		/// @details The managed signals are blocked process wide (see block()), repeated signals
+		/// are coalesced and the listeners are called outside of the signal context, from the main
+		/// loop when it's active or from the dispatcher thread when it's not.
+		class Dispatcher {
+		private:
+			Controller &controller;
+
+			/// @brief Signalfd for the managed signals.
+			int sfd = -1;
+
+			/// @brief Pipe to wake the dispatcher, written by onSignal() and by the destructor.
+			static int pipes[2];
+
+			std::thread thread;
+
+			/// @brief Set by the destructor, the thread gives up waiting for the guard.
+			std::atomic<bool> stopping{false};
+
+			void run() noexcept;
+
+		public:
+			Dispatcher(Controller &controller);
+			~Dispatcher();
+
+			/// @brief Wake the dispatcher from the signal context.
+			/// @param signum The signal number (0 to stop the dispatcher).
+			static void wakeup(int signum) noexcept;
+
+		};
+
 		Signal & SignalFactory(int signum);
 
 		std::forward_list<Signal> signals;
 
+		/// @brief The active main loop, if any.
+		MainLoop *mainloop = nullptr;
+
+		Dispatcher dispatcher{*this};
+
+		/// @brief Run the listeners for signal.
+		void dispatch(int signum) noexcept;
+
+		/// @brief Run the listeners for signal on the main loop, if active.
+		void post(int signum) noexcept;
+
 #endif // _WIN32
 
 
@@ -88,7 +137,19 @@
 #else
 
 		Event & SignalHandler(void *id, int signum, const std::function<bool()> handler);
-		static void onSignal(int signum) noexcept;
+
+		/// @brief Fallback handler for threads not blocking the signal.
+		static void onSignal(int signum, siginfo_t *info, void *context) noexcept;
+
+		/// @brief Block the managed signals (SIGHUP, SIGINT, SIGTERM, SIGUSR1 and SIGUSR2).
+		/// @details Called from the main loop and dispatcher constructors on their own threads, threads started after it inherit the mask.
+		static void block() noexcept;
+
+		/// @brief Set the main loop for the signal listeners.
+		void attach(MainLoop *mainloop) noexcept;
+
+		/// @brief Unset the main loop for the signal listeners.
+		void detach(MainLoop *mainloop) noexcept;
 
 #endif // _WIN32
 
@@ -28,6 +28,13 @@
  #include <udjat/tools/handler.h>
  #include <list>
 
+ #ifndef _WIN32
+	#include <udjat/tools/timer.h>
+	#include <unordered_map>
+	#include <string>
+	#include <vector>
+ #endif // !_WIN32
+
  #ifdef _WIN32
 	#include <udjat/win32/handler.h>
  #else
@@ -84,27 +91,102 @@
 
 		};
 #else
-		class UDJAT_PRIVATE Watcher::Controller : private MainLoop::Handler {
+		class UDJAT_PRIVATE Watcher::Controller : private MainLoop::Handler, private MainLoop::Timer {
 		private:
 
 			/// @brief A watch handler.
 			struct Handler {
 				int wd = -1;
-				std::list<File::Watcher *> files;
+				std::string path;	///< @brief The canonical path.
+				uint32_t mask = 0;	///< @brief Events requested by the non recursive watchers.
+				std::list<File::Watcher *> files;	///< @brief Watchers for this path.
+				std::list<File::Watcher *> trees;	///< @brief Recursive watchers containing this directory.
 			};
 
-			std::list<Handler> handlers;
+			/// @brief Handlers by watch descriptor.
+			std::unordered_map<int,Handler> handlers;
+
+			/// @brief Watch descriptors by canonical path.
+			std::unordered_map<std::string,int> paths;
+
+			/// @brief Canonical path of the recursive watchers.
+			std::unordered_map<File::Watcher *,std::string> roots;
+
+			/// @brief An event waiting for the debounce window.
+			struct Pending {
+				int wd;
+				uint32_t mask;
+				std::string name;
+			};
+
+			/// @brief Pending events, in arrival order.
+			std::vector<Pending> pending;
+
+			/// @brief Index of the last pending event for 'wd/name'.
+			std::unordered_map<std::string,size_t> last;
+
+			/// @brief Debounce window in milliseconds.
+			unsigned long debounce = 0;
+
+			/// @brief Maximum number of inotify watches.
+			size_t max_watches = 0;
+
+			/// @brief Maximum number of pending events.
+			size_t max_pending = 0;
+
+			/// @brief A directory waiting to be scanned by a recursive watcher.
+			struct Scan {
+				File::Watcher *watcher;
+				std::string path;
+				bool report;		///< @brief Report the existing entries as created.
+			};
+
+			/// @brief Directories left for the next pass.
+			std::vector<Scan> scans;
+
+			/// @brief Maximum number of directories scanned on each pass.
+			size_t max_scan = 0;
+
+			/// @brief Events were lost, rescan the recursive watchers.
+			bool overflow = false;
+
+			/// @brief Buffer for the inotify events.
+			std::vector<uint64_t> buffer;
+
 			std::mutex guard;
 
 			Controller();
 			void onEvent(const struct inotify_event *event) noexcept;
 
-			void watch_file(File::Watcher *watcher);
-			void watch_directory(File::Watcher *watcher);
+			/// @brief Add inotify watch for path.
+			/// @return The watch descriptor (-1 if the watch limit was reached).
+			int add_watch(const std::string &path, uint32_t mask);
+
+			/// @brief Add watches for directory and its subdirectories.
+			/// @param watcher The recursive watcher.
+			/// @param path The canonical path of the directory.
+			/// @param found If not null receives the path (relative to the watcher root) of the existing entries.
+			/// @param budget Number of directories to scan, the remaining ones are queued on 'scans'.
+			void watch_tree(File::Watcher *watcher, const std::string &path, std::vector<std::string> *found, size_t &budget);
+
+			/// @brief Remove watcher from directory and its subdirectories.
+			void unwatch_tree(File::Watcher *watcher, const std::string &path) noexcept;
+
+			/// @brief Remove the inotify watch if there's no watcher using it.
+			void release(int wd) noexcept;
+
+			void remove_watch(int wd) noexcept;
+
+			/// @brief Resync the recursive watchers after lost events.
+			void rescan() noexcept;
+
+			/// @brief Dispatch the pending events, one task for each watcher.
+			void dispatch() noexcept;
 
 		protected:
 
 			void handle_event(const MainLoop::Handler::Event event) override;
+			void on_timer() override;
 
 		public:
 			static Controller & getInstance();
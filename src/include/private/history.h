@@ -0,0 +1,211 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Declares the agent value history.
+  */
+
+ #pragma once
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/agent/abstract.h>
+ #include <udjat/tools/value.h>
+ #include <type_traits>
+ #include <cstring>
+ #include <cstdint>
+ #include <atomic>
+ #include <memory>
+ #include <mutex>
+ #include <ctime>
+
+ namespace Udjat {
+
+	/// @brief Fixed size history of agent values.
+	/// @details Keeps the raw samples and the per minute and per hour min/avg/max buckets on
+	/// preallocated rings. The writers are serialized by a mutex, the readers never block them:
+	/// every slot has a sequence number and a slot overwritten while being read is discarded.
+	class UDJAT_PRIVATE Abstract::Agent::History {
+	public:
+
+		/// @brief A raw sample.
+		struct Sample {
+			time_t timestamp = 0;
+			double value = 0;
+		};
+
+		/// @brief Downsampled values.
+		struct Bucket {
+			time_t timestamp = 0;	///< @brief Start of the bucket.
+			size_t count = 0;
+			double min = 0;
+			double max = 0;
+			double sum = 0;
+
+			void add(double value) noexcept;
+		};
+
+		/// @brief Ring of trivially copyable records, lock free for the readers.
+		template <typename T>
+		class Ring {
+		private:
+
+			static_assert(std::is_trivially_copyable<T>::value,"Ring records must be trivially copyable");
+
+			static constexpr size_t words = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+			struct Slot {
+				/// @brief (position * 2) + 2 when valid, odd while writing.
+				std::atomic<uint64_t> sequence{0};
+				std::atomic<uint64_t> data[words];
+			};
+
+			std::unique_ptr<Slot[]> slots;
+			const size_t capacity;
+
+			/// @brief Number of records written.
+			std::atomic<uint64_t> head{0};
+
+		public:
+			Ring(size_t c) : slots{new Slot[c ? c : 1]}, capacity{c ? c : 1} {
+			}
+
+			inline size_t size() const noexcept {
+				return capacity;
+			}
+
+			/// @brief Write record, the caller must serialize the writers.
+			void push(const T &record) noexcept {
+
+				uint64_t position = head.load(std::memory_order_relaxed);
+				Slot &slot = slots[position % capacity];
+
+				uint64_t buffer[words] = {};
+				memcpy(buffer,&record,sizeof(T));
+
+				slot.sequence.store((position * 2) + 1,std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+				for(size_t ix = 0; ix < words; ix++) {
+					slot.data[ix].store(buffer[ix],std::memory_order_relaxed);
+				}
+				slot.sequence.store((position * 2) + 2,std::memory_order_release);
+
+				head.store(position+1,std::memory_order_release);
+
+			}
+
+			/// @brief Get the records, from the oldest to the newest.
+			/// @param call Callback for every valid record, return true to stop.
+			template <typename Call>
+			void for_each(const Call &call) const {
+
+				uint64_t last = head.load(std::memory_order_acquire);
+				uint64_t first = last > capacity ? last - capacity : 0;
+
+				for(uint64_t position = first; position < last; position++) {
+
+					const Slot &slot = slots[position % capacity];
+
+					uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+					if(sequence != (position * 2) + 2) {
+						continue;	// Overwritten.
+					}
+
+					uint64_t buffer[words];
+					for(size_t ix = 0; ix < words; ix++) {
+						buffer[ix] = slot.data[ix].load(std::memory_order_relaxed);
+					}
+
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if(slot.sequence.load(std::memory_order_relaxed) != sequence) {
+						continue;	// Overwritten while reading.
+					}
+
+					T record;
+					memcpy(&record,buffer,sizeof(T));
+					if(call(record)) {
+						return;
+					}
+
+				}
+
+			}
+
+		};
+
+		/// @brief Downsampling level.
+		class Level {
+		public:
+			const time_t interval;
+
+			/// @brief Closed buckets.
+			Ring<Bucket> buckets;
+
+			/// @brief Open bucket, published to the readers on every sample.
+			Ring<Bucket> current{1};
+
+		private:
+			Bucket bucket;
+
+			/// @brief Append bucket to the response.
+			static void append(Value &value, const Bucket &bucket);
+
+		public:
+			Level(time_t i, size_t size) : interval{i}, buckets{size} {
+			}
+
+			void add(time_t timestamp, double value) noexcept;
+
+			void get(time_t from, Value &value) const;
+
+		};
+
+	private:
+
+		/// @brief Serialize the writers (agent updates can run on any thread).
+		std::mutex guard;
+
+		Ring<Sample> raw;
+		Level minutes;
+		Level hours;
+
+	public:
+
+		/// @brief Build history.
+		/// @param samples Number of raw samples.
+		/// @param minutes Number of 1 minute buckets.
+		/// @param hours Number of 1 hour buckets.
+		History(size_t samples, size_t minutes, size_t hours);
+
+		/// @brief Build history from agent node, if enabled.
+		/// @return The history (empty if not enabled on node).
+		static std::shared_ptr<History> Factory(const XML::Node &node);
+
+		/// @brief Store value.
+		void add(time_t timestamp, double value) noexcept;
+
+		/// @brief Get history.
+		/// @param path "raw", "minutes" or "hours", optionally followed by '/' and the number of seconds to get.
+		/// @param value Array to receive the samples.
+		/// @return false if the path is not valid.
+		bool get(const char *path, Value &value) const;
+
+	};
+
+ }
@@ -0,0 +1,107 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Declares the shared file writers.
+  */
+
+ #pragma once
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/file.h>
+ #include <memory>
+ #include <unordered_map>
+ #include <cstdint>
+ #include <string>
+ #include <vector>
+ #include <mutex>
+
+ namespace Udjat {
+
+	namespace File {
+
+		/// @brief Append only writer shared by everyone writing to the same file.
+		/// @details Keeps the descriptor open between writes; concurrent writers are combined in a
+		/// single writev by the first one to get the descriptor. A background timer syncs the written
+		/// files, rotates the oversized ones, reopens the files renamed or removed by someone else
+		/// and closes the idle ones.
+		class UDJAT_PRIVATE Sink {
+		private:
+
+			const std::string filename;
+
+			/// @brief Protects the pending list and the counters.
+			std::mutex guard;
+
+			/// @brief Protects the descriptor.
+			std::mutex io;
+
+			int fd = -1;
+
+			time_t updated = 0;		///< @brief Last file modification.
+			time_t used = 0;		///< @brief Last write request.
+			time_t synced = 0;		///< @brief Last fdatasync().
+			bool dirty = false;		///< @brief Written since the last fdatasync().
+			size_t maxsize = 0;		///< @brief Rotate when the file is bigger than this.
+
+			/// @brief Lines waiting for the writer.
+			std::vector<std::string> pending;
+
+			uint64_t queued = 0;	///< @brief Last queued request.
+			uint64_t written = 0;	///< @brief Last request handled by the writer.
+
+			/// @brief Error codes of the failed requests, removed by their writers.
+			std::unordered_map<uint64_t,int> failures;
+
+			/// @brief Open file, io must be locked.
+			void open();
+
+			/// @brief Close file, io must be locked.
+			void close() noexcept;
+
+			/// @brief Write the pending lines, io must be locked.
+			void flush(time_t maxage) noexcept;
+
+			/// @brief Sync, rotate or close the file.
+			/// @return true if the sink is idle and closed.
+			bool maintain(time_t now, time_t interval, time_t idle) noexcept;
+
+			/// @brief Run maintain() on every sink, release the idle ones.
+			static void maintenance() noexcept;
+
+		public:
+			Sink(const char *filename);
+			~Sink();
+
+			/// @brief Get the writer for filename.
+			static std::shared_ptr<Sink> getInstance(const char *filename);
+
+			/// @brief Append lines to file.
+			/// @param lines The lines to write (without line feed).
+			/// @param maxage Remove the file if not modified for this many seconds (0 to keep).
+			/// @param maxsize Rotate the file when bigger than this (0 for no limit).
+			/// @exception std::system_error if the write fails.
+			void write(const std::vector<std::string> &lines, time_t maxage = 0, size_t maxsize = 0);
+
+		};
+
+	}
+
+ }
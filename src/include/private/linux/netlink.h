@@ -27,6 +27,14 @@
  #include <functional>
  #include <linux/rtnetlink.h>
  #include <sys/ioctl.h>
+ #include <udjat/tools/mainloop.h>
+ #include <udjat/tools/handler.h>
+ #include <cstdint>
+ #include <string>
+ #include <vector>
+ #include <memory>
+ #include <mutex>
+ #include <list>
 
  using namespace std;
 
@@ -59,4 +67,167 @@
 
  };
 
- UDJAT_PRIVATE bool netlink_routes(const std::function<bool(const struct nlmsghdr *msg)> &func);
+ namespace Udjat {
+
+	namespace Netlink {
+
+		/// @brief Network link.
+		struct Link {
+			int index = 0;
+			unsigned int flags = 0;		///< @brief Interface flags (IFF_*).
+			unsigned int mtu = 0;
+			uint8_t operstate = 0;		///< @brief RFC 2863 operational state (IF_OPER_*).
+			std::string name;
+			std::string macaddress;		///< @brief Hardware address, as hex digits (empty if not available).
+
+			/// @brief Interface counters (IFLA_STATS64).
+			struct Statistics {
+				uint64_t rx_packets = 0;
+				uint64_t tx_packets = 0;
+				uint64_t rx_bytes = 0;
+				uint64_t tx_bytes = 0;
+				uint64_t rx_errors = 0;
+				uint64_t tx_errors = 0;
+				uint64_t rx_dropped = 0;
+				uint64_t tx_dropped = 0;
+			} stats;
+
+			/// @brief Load link from RTM_NEWLINK/RTM_DELLINK message.
+			/// @return false if the message is not a valid link message.
+			bool set(const struct nlmsghdr *msg);
+
+			/// @brief Get the operational state name ("up", "down", "dormant", ...).
+			const char * state() const noexcept;
+
+			/// @brief Parse a RTM_GETLINK response.
+			/// @param links The vector to append the links.
+			/// @param buffer The netlink messages, as received from the socket.
+			/// @param length The buffer length.
+			/// @return true if the buffer has the end of the response (NLMSG_DONE, NLMSG_ERROR or a non multipart message).
+			static bool parse(std::vector<Link> &links, const void *buffer, size_t length);
+
+			/// @brief Get links, with current statistics, from a single RTM_GETLINK request.
+			/// @param index The interface index (0 to get all links).
+			static std::vector<Link> snapshot(int index = 0);
+
+		};
+
+		/// @brief Interface address.
+		struct Address {
+			int index = 0;				///< @brief Interface index.
+			uint8_t prefix = 0;			///< @brief Prefix length.
+			sockaddr_storage address{};
+			sockaddr_storage netmask{};
+		};
+
+		/// @brief Route.
+		struct Route {
+			uint8_t family = AF_UNSPEC;
+			uint8_t length = 0;			///< @brief Destination prefix length (0 for default routes).
+			uint32_t table = RT_TABLE_MAIN;
+			uint32_t priority = 0;
+			int oif = 0;				///< @brief Output interface index (0 if not available).
+			sockaddr_storage destination{};
+			sockaddr_storage gateway{};	///< @brief Gateway (AF_UNSPEC if not available).
+		};
+
+		/// @brief Cached copy of the kernel link, address and route tables.
+		/// @details Keeps a NETLINK_ROUTE socket subscribed to the link, address and route
+		/// multicast groups; the tables are loaded once and updated from the change
+		/// notifications, on the main loop or before every query.
+		class UDJAT_PRIVATE Monitor : public MainLoop::Handler {
+		public:
+
+			/// @brief The tables, replaced (never changed) on updates.
+			struct Tables {
+				std::vector<Link> links;
+				std::vector<Address> addresses;
+				std::vector<Route> routes;
+
+				/// @brief Get link by index.
+				const Link * find(int index) const noexcept;
+
+				/// @brief Get link by name.
+				const Link * find(const char *name) const noexcept;
+
+				/// @brief Get the main table default route with the lowest metric.
+				/// @param family The address family.
+				/// @return The default route (nullptr if not available).
+				const Route * route(int family = AF_INET) const noexcept;
+
+			};
+
+		private:
+
+			/// @brief Serialize the socket reads and the table updates.
+			std::mutex guard;
+
+			uint32_t sequence = 0;
+
+			std::shared_ptr<const Tables> tables;
+
+			struct Listener {
+				const void *id;
+				std::function<void(uint16_t type)> call;
+			};
+
+			std::list<Listener> listeners;
+
+			std::vector<char> buffer;
+
+			/// @brief Kernel has dropped notifications, tables should be reloaded.
+			bool overrun = false;
+
+			/// @brief Load the tables from the kernel.
+			void load();
+
+			/// @brief Send dump request and wait for the response.
+			void dump(Tables &tables, uint16_t type, const void *request, size_t length);
+
+			/// @brief Read and apply pending messages.
+			/// @param tables The tables to update.
+			/// @param changes The types of the applied messages.
+			/// @param seq Sequence of the dump request (0 for none).
+			/// @return true if the dump request has finished.
+			bool receive(Tables &tables, std::vector<uint16_t> &changes, uint32_t seq);
+
+			/// @brief Apply a single message.
+			/// @return true if the message has changed the tables.
+			static bool apply(Tables &tables, const struct nlmsghdr *msg);
+
+		protected:
+			void handle_event(const Event event) override;
+
+		public:
+
+			/// @brief Create monitor subscribed to the kernel notifications.
+			Monitor();
+
+			/// @brief Create monitor reading from an already connected socket (no subscription, no dump).
+			/// @param fd Datagram socket with netlink messages (like a socketpair feeding recorded messages).
+			explicit Monitor(int fd);
+
+			~Monitor();
+
+			static Monitor & getInstance();
+
+			/// @brief Apply the pending notifications.
+			void flush() override;
+
+			/// @brief Get current tables, after applying the pending notifications.
+			std::shared_ptr<const Tables> get();
+
+			/// @brief Insert change listener.
+			/// @param id The listener id.
+			/// @param call Method to call with the message type (RTM_NEWLINK, RTM_DELADDR, RTM_NEWROUTE, ...) on every change,
+			/// or with 0 when the tables were reloaded after a socket overrun.
+			void push_back(const void *id, const std::function<void(uint16_t type)> &call);
+
+			/// @brief Remove change listeners.
+			void remove(const void *id);
+
+		};
+
+	}
+
+ }
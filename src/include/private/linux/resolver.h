@@ -0,0 +1,74 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Declares the cached name resolver.
+  */
+
+ #pragma once
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <sys/types.h>
+ #include <sys/socket.h>
+ #include <memory>
+ #include <vector>
+
+ namespace Udjat {
+
+	/// @brief Asynchronous, cached name resolver.
+	/// @details Lookups run on dedicated resolver threads, concurrent requests for the same name
+	/// share a single query and the results (including failures) are cached for a configurable time.
+	class UDJAT_PRIVATE Resolver {
+	public:
+
+		/// @brief A resolved address.
+		struct Address {
+			int family = AF_UNSPEC;
+			int socktype = SOCK_STREAM;
+			int protocol = 0;
+			socklen_t length = 0;
+			struct sockaddr_storage addr;
+		};
+
+		/// @brief Lookup result.
+		struct Result {
+			int error = 0;	///< @brief getaddrinfo() error code (0 on success).
+			std::vector<Address> addresses;
+		};
+
+		/// @brief Resolve hostname.
+		/// @param hostname The hostname.
+		/// @param service The service name or port.
+		/// @param seconds Maximum time to wait for the resolver.
+		/// @return The lookup result, check 'error' for failures.
+		/// @exception std::system_error ETIMEDOUT if the lookup has not finished in time.
+		static std::shared_ptr<const Result> resolve(const char *hostname, const char *service, unsigned int seconds);
+
+		/// @brief Connect to the first address accepting the connection.
+		/// @details Happy eyeballs (RFC 8305): alternate the address families, starting a new
+		/// attempt when the previous one fails or is still pending after the attempt delay.
+		/// @param addresses The addresses to try.
+		/// @param seconds Timeout for the connection.
+		/// @return A non-blocking, connected socket (-1 and errno on failure).
+		static int connect(const std::vector<Address> &addresses, unsigned int seconds) noexcept;
+
+	};
+
+ }
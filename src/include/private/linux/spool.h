@@ -0,0 +1,146 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Declares the persistent alert spool.
+  */
+
+ #pragma once
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/alert.h>
+ #include <udjat/tools/timer.h>
+ #include <unordered_map>
+ #include <cstdint>
+ #include <string>
+ #include <mutex>
+ #include <list>
+
+ namespace Udjat {
+
+	/// @brief Durable, append-only queue of rendered alert payloads.
+	/// @details Payloads are stored on memory mapped segment files in the 'alerts' cache directory
+	/// and delivered in background, in order for each destination, by a batched sender with
+	/// exponential backoff. Undelivered payloads are loaded again when the application restarts.
+	class UDJAT_PRIVATE Alert::Spool {
+	public:
+
+		/// @brief Method for file destinations (append payload to file).
+		static constexpr uint8_t Append = 0xFF;
+
+	private:
+
+		/// @brief Segment file header.
+		struct Header {
+			char magic[8];
+			uint32_t version;
+			uint32_t reserved;
+		};
+
+		/// @brief Record header, followed by the destination and payload.
+		struct Record {
+			uint32_t magic;			///< @brief Set after the record data was written.
+			uint8_t state;			///< @brief 0 = pending, 1 = delivered.
+			uint8_t method;			///< @brief HTTP method or Append.
+			uint16_t reserved;
+			uint32_t destination;	///< @brief Length of the destination.
+			uint32_t payload;		///< @brief Length of the payload.
+
+			// Version 2 segments.
+			uint64_t maxsize;		///< @brief Append: rotate the file when bigger than this.
+			uint32_t maxage;		///< @brief Append: remove the file if not modified for this many seconds.
+			uint32_t options;
+		};
+
+		/// @brief A mapped segment file.
+		struct Segment {
+			std::string filename;
+			uint8_t *data = nullptr;
+			size_t size = 0;		///< @brief Mapped length.
+			size_t used = 0;		///< @brief Offset for the next record.
+			size_t cursor = 0;		///< @brief Offset of the first undelivered record.
+			size_t header = sizeof(Record);	///< @brief Length of the record headers (shorter on version 1).
+			size_t pending = 0;		///< @brief Number of undelivered records.
+		};
+
+		/// @brief Delivery state of a destination.
+		struct Backoff {
+			unsigned int failures = 0;
+			time_t next = 0;
+		};
+
+		std::mutex guard;
+
+		Timer *timer;
+
+		/// @brief Segments, oldest first; new records are appended to the last one.
+		std::list<Segment> segments;
+
+		std::unordered_map<std::string,Backoff> backoff;
+
+		std::string path;			///< @brief The spool directory.
+		uint64_t sequence = 0;		///< @brief Number of the last segment file.
+		bool draining = false;		///< @brief True if the sender is running.
+
+		struct {
+			size_t segment;			///< @brief Segment file size.
+			size_t batch;			///< @brief Maximum number of records on each delivery.
+			unsigned int retry;		///< @brief Seconds to wait after the first failure.
+			unsigned int maxretry;	///< @brief Maximum seconds between retries.
+			bool sync;				///< @brief Wait for the records to reach the disk.
+		} limits;
+
+		Spool();
+
+		/// @brief Load segment file from a previous run.
+		void load(const char *filename);
+
+		/// @brief Create a new segment with at least 'length' bytes for records.
+		Segment & create(size_t length);
+
+		/// @brief Unmap and remove delivered segments.
+		void release() noexcept;
+
+		/// @brief Move the segment cursor past the delivered records.
+		static void advance(Segment &segment) noexcept;
+
+		/// @brief Deliver records.
+		/// @return 0 if all records were delivered, seconds to wait for the next retry if not.
+		time_t drain();
+
+		/// @brief Start the sender on the thread pool, if not running.
+		void start() noexcept;
+
+	public:
+		~Spool();
+
+		static Spool & getInstance();
+
+		/// @brief Store payload for delivery.
+		/// @param destination The file name (for Append) or URL.
+		/// @param method Append or the HTTP method.
+		/// @param payload The rendered payload.
+		/// @param maxage For Append, remove the file if not modified for this many seconds (0 to keep).
+		/// @param maxsize For Append, rotate the file when bigger than this (0 for no limit).
+		void push(const char *destination, uint8_t method, const char *payload, time_t maxage = 0, size_t maxsize = 0);
+
+	};
+
+ }
@@ -22,6 +22,7 @@
  #include <udjat/defs.h>
  #include <udjat/tools/subprocess.h>
  #include <udjat/tools/handler.h>
+ #include <udjat/tools/timer.h>
  #include <udjat/tools/container.h>
  #include <private/event.h>
  #include <mutex>
@@ -53,33 +54,29 @@
 
 	};
 
-	class UDJAT_PRIVATE SubProcess::Controller {
+	/// @brief Reap the child processes.
+	/// @details Each async child is watched by a pidfd on the main loop, so the exit is handled
+	/// without signal handlers; kernels without pidfd support fall back to a polling timer.
+	class UDJAT_PRIVATE SubProcess::Controller : private MainLoop::Timer {
 	public:
 
+		/// @brief Watch the exit of a child process.
+		class Watcher;
+
 		struct Entry {
 			std::shared_ptr<SubProcess> proc;				///< @brief The process object.
 			std::shared_ptr<SubProcess::Handler> out;		///< @brief The output stream.
 			std::shared_ptr<SubProcess::Handler> err;		///< @brief The error stream.
+			std::shared_ptr<Watcher> watcher;				///< @brief The pidfd handler (empty if not available).
 		};
 
 	private:
 		Controller();
 
-#if __cplusplus >= 201703L
 		Container<Entry,Entry> entries;
-#else
-		class Entries : public std::list<Entry>, public std::mutex {
-		public:
-			Entries() {
-			}
-		
-
-		} entries;
-#endif
 
-		static void handle_signal(int sig) noexcept;
-
-		void child_ended(pid_t pid, int status) noexcept;
+		/// @brief Check the children without pidfd.
+		void on_timer() override;
 
 	public:
 
@@ -93,11 +90,32 @@
 		/// @brief Initialize subprocess.
 		static void init(SubProcess &proc, Handler &out, Handler &err);
 
-		inline void push_back(const Entry &entry) {
-			entries.push_back(entry);
-		}
+		/// @brief Start watching child.
+		void push_back(Entry &entry);
+
+		/// @brief Handle the exit of a child process.
+		/// @param pid The pid of the reaped child.
+		/// @param status The status from waitpid().
+		void child_ended(pid_t pid, int status) noexcept;
 
  	};
 
+	class UDJAT_PRIVATE SubProcess::Controller::Watcher : public MainLoop::Handler {
+	private:
+		pid_t pid;
+
+	protected:
+		void handle_event(const Event event) override;
+
+	public:
+
+		/// @brief Open a pidfd for the child process.
+		/// @return The pidfd handler (empty if pidfd is not available).
+		static std::shared_ptr<Watcher> factory(pid_t pid);
+
+		Watcher(pid_t pid, int fd);
+		~Watcher();
+
+	};
 
  }
@@ -0,0 +1,222 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+ /**
+  * @brief Declares the io_uring file I/O engine.
+  */
+
+ #pragma once
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/mainloop.h>
+ #include <udjat/tools/handler.h>
+ #include <sys/types.h>
+ #include <sys/stat.h>
+ #include <condition_variable>
+ #include <functional>
+ #include <atomic>
+ #include <cstdint>
+ #include <string>
+ #include <vector>
+ #include <mutex>
+
+ struct io_uring_sqe;
+ struct io_uring_cqe;
+
+ namespace Udjat {
+
+	/// @brief Process wide io_uring submission ring.
+	/// @details Detected at runtime, it can be disabled with the 'io-uring' option of the [file] section;
+	/// getInstance() returns nullptr when it's disabled, when the kernel has
+	/// no io_uring (or it was disabled by policy) and after a ring failure, so the callers keep
+	/// their plain syscall path as fallback.
+	/// Asynchronous completions are delivered on the main loop through an eventfd, batches
+	/// are waited by the calling thread.
+	class UDJAT_PRIVATE URing : private MainLoop::Handler {
+	public:
+
+		/// @brief Completion callback.
+		/// @param result The operation result (negative errno on failure).
+		using Callback = std::function<void(int result)>;
+
+		/// @brief Operations submitted together and waited by the calling thread.
+		class UDJAT_PRIVATE Batch {
+		private:
+			friend class URing;
+
+			struct Operation {
+				uint8_t opcode;
+				int fd;
+				uint64_t addr;
+				uint32_t len;
+				uint64_t off;
+				uint32_t flags;
+				std::string path;
+			};
+
+			std::vector<Operation> operations;
+			std::vector<int> results;
+			size_t remaining = 0;
+
+			/// @brief Submit and wait a slice of the operations, no larger than the ring.
+			void run(URing &uring, size_t from, size_t to);
+
+			/// @brief Run operation with the plain syscalls.
+			/// @return The operation result (negative errno on failure).
+			static int execute(const Operation &operation) noexcept;
+
+		public:
+
+			void read(int fd, void *buf, size_t length, uint64_t offset);
+			void write(int fd, const void *buf, size_t length, uint64_t offset);
+			void openat(int dirfd, const char *path, int flags, mode_t mode);
+			void fsync(int fd, bool datasync = false);
+			void statx(int dirfd, const char *path, int flags, unsigned int mask, struct statx *buf);
+
+			inline size_t size() const noexcept {
+				return operations.size();
+			}
+
+			/// @brief Get the result of an operation (negative errno on failure).
+			inline int operator[](size_t index) const {
+				return results.at(index);
+			}
+
+			/// @brief Submit the operations and wait for all of them (with the plain syscalls if the ring is not available).
+			void run();
+
+			/// @brief Remove the operations and results.
+			void clear() noexcept;
+
+		};
+
+	private:
+
+		struct Request;
+
+		/// @brief Mapped rings.
+		struct {
+			unsigned int *head = nullptr;
+			unsigned int *tail = nullptr;
+			unsigned int *mask = nullptr;
+			unsigned int *array = nullptr;
+			unsigned int entries = 0;
+			struct io_uring_sqe *sqes = nullptr;
+			unsigned int queued = 0;		///< @brief SQEs filled but not submitted.
+		} sq;
+
+		struct {
+			unsigned int *head = nullptr;
+			unsigned int *tail = nullptr;
+			unsigned int *mask = nullptr;
+			unsigned int *flags = nullptr;	///< @brief CQ flags (nullptr if not supported).
+			struct io_uring_cqe *cqes = nullptr;
+		} cq;
+
+		struct Mapping {
+			void *addr = nullptr;
+			size_t length = 0;
+		} mappings[3];
+
+		int ring = -1;
+
+		std::mutex guard;
+
+		/// @brief Signaled after every reap, for the threads waiting batches.
+		std::condition_variable reaped;
+
+		/// @brief A thread is blocked on io_uring_enter() waiting completions.
+		bool waiting = false;
+
+		/// @brief Asynchronous requests in flight, the eventfd is only signaled when non zero.
+		size_t async = 0;
+
+		/// @brief io_uring_enter() has failed, don't use the engine anymore.
+		std::atomic<bool> failed{false};
+
+		URing();
+
+		/// @brief Get the number of free SQEs.
+		unsigned int space() const noexcept;
+
+		/// @brief Get the next free SQE, there must be space().
+		struct io_uring_sqe * next(Request *request) noexcept;
+
+		/// @brief Get a free SQE, submit the queued ones if the ring is full.
+		struct io_uring_sqe * get(Request *request);
+
+		/// @brief Make the queued SQEs visible to the kernel.
+		/// @return Number of SQEs not yet consumed by the kernel.
+		unsigned int publish() noexcept;
+
+		/// @brief Submit the queued SQEs.
+		void submit();
+
+		/// @brief Process the available completions.
+		/// @param completed Receives the asynchronous requests, to be delivered without lock.
+		void reap(std::vector<std::pair<Request *,int>> &completed);
+
+		/// @brief Deliver completed asynchronous requests.
+		/// @param mainloop true if running on the main loop, otherwise the callbacks are posted to it.
+		static void deliver(std::vector<std::pair<Request *,int>> &completed, bool mainloop) noexcept;
+
+		/// @brief Enable or disable the eventfd notifications.
+		void notify(bool enable) noexcept;
+
+		/// @brief Fill SQE.
+		static void prepare(struct io_uring_sqe *sqe, const Batch::Operation &operation, const char *path) noexcept;
+
+		/// @brief Queue an asynchronous operation.
+		void queue(const Batch::Operation &operation, const Callback &call);
+
+	protected:
+		void handle_event(const Event event) override;
+
+	public:
+		URing(const URing &) = delete;
+		URing(const URing *) = delete;
+
+		~URing();
+
+		/// @brief Get the engine.
+		/// @return The engine, nullptr if io_uring is not available.
+		static URing * getInstance() noexcept;
+
+		void read(int fd, void *buf, size_t length, uint64_t offset, const Callback &call);
+		void write(int fd, const void *buf, size_t length, uint64_t offset, const Callback &call);
+		void openat(int dirfd, const char *path, int flags, mode_t mode, const Callback &call);
+		void fsync(int fd, bool datasync, const Callback &call);
+		void statx(int dirfd, const char *path, int flags, unsigned int mask, struct statx *buf, const Callback &call);
+
+		/// @brief Copy file contents, reading the next block while writing the current one.
+		/// @param from The source file.
+		/// @param offset The source offset.
+		/// @param to The destination file.
+		/// @param destination The destination offset.
+		/// @param length Maximum number of bytes to copy (stops at end of file).
+		/// @param blksize The block size.
+		/// @param progress Called after every block with the bytes copied, returns true to cancel.
+		/// @return The number of bytes copied.
+		uint64_t copy(int from, uint64_t offset, int to, uint64_t destination, uint64_t length, size_t blksize, const std::function<bool(uint64_t copied)> &progress);
+
+	};
+
+ }
@@ -0,0 +1,209 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Declares the name indexed registry used by the factory lists.
+  */
+
+ #pragma once
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/quark.h>
+ #include <unordered_map>
+ #include <functional>
+ #include <cstring>
+ #include <cctype>
+ #include <vector>
+ #include <mutex>
+ #include <list>
+
+ namespace Udjat {
+
+	namespace Abstract {
+
+		/// @brief Non template part of the factory registry.
+		/// @details Keeps track of the active registries to report load statistics.
+		class UDJAT_PRIVATE Registry {
+		private:
+			const char *registry_name;
+
+		protected:
+
+			/// @brief Case insensitive hash for interned names.
+			struct Hash {
+				inline size_t operator()(const char *str) const noexcept {
+					// https://stackoverflow.com/questions/7666509/hash-function-for-string
+					size_t value = 5381;
+					for(const char *ptr = str; *ptr; ptr++) {
+						value = ((value << 5) + value) + tolower((unsigned char) *ptr);
+					}
+					return value;
+				}
+			};
+
+			/// @brief Case insensitive compare for interned names.
+			struct Equal {
+				inline bool operator()(const char *a, const char *b) const noexcept {
+					return a == b || strcasecmp(a,b) == 0;
+				}
+			};
+
+			Registry(const char *name);
+
+		public:
+			Registry(const Registry&) = delete;
+			Registry& operator=(const Registry &) = delete;
+			Registry(Registry &&) = delete;
+			Registry & operator=(Registry &&) = delete;
+
+			virtual ~Registry();
+
+			inline const char * name() const noexcept {
+				return registry_name;
+			}
+
+			/// @brief Get the number of nodes handled by each factory.
+			/// @param call Callback receiving the factory name and the node count.
+			virtual void statistics(const std::function<void(const char *name, size_t count)> &call) const = 0;
+
+			/// @brief Write the node count of every registered factory to the trace log.
+			static void trace() noexcept;
+
+		};
+
+	}
+
+	/// @brief Factory list indexed by case insensitive name.
+	/// @details Names are interned as quarks, so the index keeps valid keys even after the module
+	/// which registered the factory is unloaded. Factories with the same name are kept in registration order.
+	/// @tparam T The factory class.
+	template <class T>
+	class UDJAT_PRIVATE Registry : public Abstract::Registry {
+	private:
+
+		struct Entry {
+			T *factory;
+			size_t count = 0;	///< @brief Number of XML nodes handled by the factory.
+			Entry(T *f) : factory{f} {
+			}
+		};
+
+		mutable std::mutex guard;
+
+		/// @brief Factories by name.
+		std::unordered_map<const char *, std::list<Entry>, Hash, Equal> index;
+
+		/// @brief Factories in registration order.
+		std::list<T *> objects;
+
+	public:
+		Registry(const char *name) : Abstract::Registry{name} {
+		}
+
+		/// @brief Insert factory.
+		/// @param name The factory name.
+		/// @param factory The factory to insert.
+		void insert(const char *name, T *factory) {
+			std::lock_guard<std::mutex> lock(guard);
+			index[Quark{name}.c_str()].emplace_back(factory);
+			objects.push_back(factory);
+		}
+
+		/// @brief Remove factory.
+		/// @param name The factory name.
+		/// @param factory The factory to remove.
+		void remove(const char *name, T *factory) noexcept {
+			std::lock_guard<std::mutex> lock(guard);
+			objects.remove(factory);
+			auto it = index.find(name ? name : "");
+			if(it != index.end()) {
+				it->second.remove_if([factory](const Entry &entry){
+					return entry.factory == factory;
+				});
+				if(it->second.empty()) {
+					index.erase(it);
+				}
+			}
+		}
+
+		/// @brief Get factories for name.
+		/// @param name The factory name.
+		/// @return Copy of the factory list, safe to iterate while other factories are inserted or removed.
+		/// @details The factories are not owned by the registry, the pointers are valid only while
+		/// the modules who registered them are loaded.
+		std::vector<T *> find(const char *name) const {
+			std::vector<T *> factories;
+			std::lock_guard<std::mutex> lock(guard);
+			auto it = index.find(name ? name : "");
+			if(it != index.end()) {
+				factories.reserve(it->second.size());
+				for(const Entry &entry : it->second) {
+					factories.push_back(entry.factory);
+				}
+			}
+			return factories;
+		}
+
+		/// @brief Get the first factory registered for name.
+		/// @param name The factory name.
+		/// @return The factory (nullptr if not found).
+		T * front(const char *name) const noexcept {
+			std::lock_guard<std::mutex> lock(guard);
+			auto it = index.find(name ? name : "");
+			if(it == index.end() || it->second.empty()) {
+				return nullptr;
+			}
+			return it->second.front().factory;
+		}
+
+		/// @brief Get all factories in registration order.
+		std::vector<T *> list() const {
+			std::lock_guard<std::mutex> lock(guard);
+			return std::vector<T *>{objects.begin(),objects.end()};
+		}
+
+		/// @brief Count a node handled by factory.
+		/// @param name The factory name.
+		/// @param factory The factory who handled the node.
+		void count(const char *name, const T *factory) noexcept {
+			std::lock_guard<std::mutex> lock(guard);
+			auto it = index.find(name ? name : "");
+			if(it != index.end()) {
+				for(Entry &entry : it->second) {
+					if(entry.factory == factory) {
+						entry.count++;
+						return;
+					}
+				}
+			}
+		}
+
+		void statistics(const std::function<void(const char *name, size_t count)> &call) const override {
+			std::lock_guard<std::mutex> lock(guard);
+			for(const auto &it : index) {
+				for(const Entry &entry : it.second) {
+					call(it.first,entry.count);
+				}
+			}
+		}
+
+	};
+
+ }
@@ -0,0 +1,75 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Declares the serialized agent response cache.
+  */
+
+ #pragma once
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/agent/abstract.h>
+ #include <udjat/tools/http/mimetype.h>
+ #include <cstdint>
+ #include <memory>
+ #include <string>
+ #include <vector>
+ #include <mutex>
+
+ namespace Udjat {
+
+	/// @brief Serialized agent responses.
+	/// @details Keeps one serialized response for each requested mimetype, valid while the agent
+	/// generation is not changed; since the generation rolls up to the parents, a change on any agent
+	/// invalidates only the snapshots of the agent and its ancestors.
+	class UDJAT_PRIVATE Abstract::Agent::Snapshot {
+	private:
+
+		struct Entry {
+			MimeType mimetype;
+			uint64_t generation;
+			std::shared_ptr<const std::string> contents;
+		};
+
+		std::mutex guard;
+
+		/// @brief Snapshots by mimetype (just a few, a vector is faster than a map).
+		std::vector<Entry> entries;
+
+	public:
+
+		/// @brief Get the snapshot for agent, create it if necessary.
+		static std::shared_ptr<Snapshot> getInstance(const Abstract::Agent &agent);
+
+		/// @brief Get serialized response.
+		/// @param mimetype The response mimetype.
+		/// @param generation The current agent generation.
+		/// @return The serialized response (empty if not available for this generation).
+		std::shared_ptr<const std::string> get(const MimeType mimetype, uint64_t generation);
+
+		/// @brief Store serialized response.
+		/// @param mimetype The response mimetype.
+		/// @param generation The agent generation when the response was built.
+		/// @param contents The serialized response.
+		void set(const MimeType mimetype, uint64_t generation, std::shared_ptr<const std::string> contents);
+
+	};
+
+ }
@@ -23,6 +23,8 @@
 #include <udjat/defs.h>
 #include <udjat/tools/url.h>
 #include <udjat/tools/url/handler.h>
+#include <udjat/tools/file/handler.h>
+#include <functional>
 #include <string>
 
 #ifdef HAVE_SMBIOS
@@ -31,20 +33,62 @@
 
 namespace Udjat {
 
+	/// @brief Sink appending the response to a string.
+	class UDJAT_PRIVATE StringURLSink : public URL::Handler::Sink {
+	private:
+		std::string &str;
+		uint64_t total = 0;
+		std::function<bool(uint64_t current, uint64_t total)> notify;
+
+	public:
+		StringURLSink(std::string &s, const std::function<bool(uint64_t current, uint64_t total)> &p) : str{s}, notify{p} {
+		}
+
+		void allocate(uint64_t total) override;
+		bool write(uint64_t offset, const void *data, size_t length) override;
+		bool progress(uint64_t current, uint64_t total) override;
+
+	};
+
+	/// @brief Sink writing the response to a file.
+	class UDJAT_PRIVATE FileURLSink : public URL::Handler::Sink {
+	private:
+		File::Handler &file;
+		uint64_t total = 0;
+		std::function<bool(uint64_t current, uint64_t total)> notify;
+
+	public:
+		FileURLSink(File::Handler &f, const std::function<bool(uint64_t current, uint64_t total)> &p) : file{f}, notify{p} {
+		}
+
+		void allocate(uint64_t total) override;
+		bool write(uint64_t offset, const void *data, size_t length) override;
+		bool progress(uint64_t current, uint64_t total) override;
+		int descriptor() const noexcept override;
+
+	};
+
 	/// @brief Handle File:// URL.
 	class UDJAT_PRIVATE FileURLHandler : public URL::Handler {	
 	private:
 		String path;
 
 	public:
+		using URL::Handler::perform;
+
 		FileURLHandler(const URL &url);
 
 		const char *c_str() const noexcept override;
 
+		/// @brief Send file to sink, using mmap or an in kernel copy when possible.
+		int perform(const HTTP::Method method, const char *payload, Sink &sink) override;
+
 		int perform(const HTTP::Method method, const char *payload, const std::function<bool(uint64_t current, uint64_t total, const void *data, size_t len)> &progress) override;
 
 		int test(const HTTP::Method method = HTTP::Head, const char *payload = "") override;
 
+		/// @brief The handler keeps only the file path, it can always be reused.
+		bool reset() override;
 
 	};
 
@@ -54,6 +98,8 @@ namespace Udjat {
 		String path;
 
 	public:
+		using URL::Handler::perform;
+
 		ScriptURLHandler(const URL &url) : path{url.path().c_str()} {
 		}
 
@@ -63,6 +109,8 @@ namespace Udjat {
 
 		int test(const HTTP::Method method = HTTP::Head, const char *payload = "") override;
 
+		/// @brief The handler keeps only the script path, it can always be reused.
+		bool reset() override;
 
 	};
 
@@ -75,6 +123,7 @@ namespace Udjat {
 		MimeType mimetype = MimeType::json; ///< @brief The requested mimetype, default is 'application/json'.
 
 	public:
+		using URL::Handler::perform;
 
 		SMBiosURLHandler(const URL &url);
 
@@ -88,6 +137,9 @@ namespace Udjat {
 
 		Handler & set(const MimeType mimetype) override;
 
+		/// @brief Restore the default mimetype, the handler can be reused.
+		bool reset() override;
+
 	};
 #endif
 
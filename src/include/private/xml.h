@@ -0,0 +1,146 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Declares the attribute resolution index for XML documents.
+  */
+
+ #pragma once
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/xml.h>
+ #include <unordered_map>
+ #include <functional>
+ #include <string_view>
+ #include <cstring>
+ #include <cctype>
+ #include <string>
+ #include <vector>
+
+ namespace Udjat {
+
+	namespace XML {
+
+		/// @brief Symbol table for the nodes of a loaded document.
+		/// @details Built once when the document is loaded, maps every element to its children by tag name
+		/// and to its <attribute> children by the (case insensitive) 'name' attribute, so the upward
+		/// searches don't need to scan the children of every parent node on every lookup.
+		/// Nodes from documents without index are searched directly on the XML tree.
+		class UDJAT_PRIVATE Index {
+		public:
+
+			struct NodeHash {
+				inline size_t operator()(const XML::Node &node) const noexcept {
+					return node.hash_value();
+				}
+			};
+
+		private:
+
+			/// @brief Hash for tag names.
+			struct TagHash {
+				inline size_t operator()(const char *str) const noexcept {
+					return std::hash<std::string_view>{}(str);
+				}
+			};
+
+			struct TagEqual {
+				inline bool operator()(const char *a, const char *b) const noexcept {
+					return a == b || strcmp(a,b) == 0;
+				}
+			};
+
+			/// @brief Case insensitive hash for attribute names.
+			struct NameHash {
+				inline size_t operator()(const char *str) const noexcept {
+					size_t value = 5381;
+					for(const char *ptr = str; *ptr; ptr++) {
+						value = ((value << 5) + value) + tolower((unsigned char) *ptr);
+					}
+					return value;
+				}
+			};
+
+			struct NameEqual {
+				inline bool operator()(const char *a, const char *b) const noexcept {
+					return a == b || strcasecmp(a,b) == 0;
+				}
+			};
+
+			/// @brief An <attribute> child.
+			struct Entry {
+				XML::Node node;
+				size_t position;	///< @brief Position of the node between its siblings.
+			};
+
+			/// @brief The symbols of a single element.
+			/// @details Keys point to the names stored on the document, the index is rebuilt when
+			/// the library changes the document.
+			struct Scope {
+				/// @brief Children by tag name.
+				std::unordered_map<const char *,std::vector<XML::Node>,TagHash,TagEqual> children;
+
+				/// @brief <attribute> children by name.
+				std::unordered_map<const char *,std::vector<Entry>,NameHash,NameEqual> attributes;
+			};
+
+			std::unordered_map<XML::Node,Scope,NodeHash> scopes;
+
+			/// @brief Number of indexed elements.
+			size_t count = 0;
+
+			Index(const XML::Node &root);
+
+			void build(const XML::Node &node);
+
+			const Scope * scope(const XML::Node &node) const noexcept;
+
+		public:
+
+			/// @brief Build (or rebuild) the index for document.
+			static void insert(const pugi::xml_document &document);
+
+			/// @brief Remove the index of document.
+			static void remove(const pugi::xml_document &document) noexcept;
+
+			/// @brief Rebuild the index of the document containing node, if indexed.
+			/// @details Required after changing an indexed document.
+			static void refresh(const XML::Node &node);
+
+			/// @brief Get the first <attribute> child of node with the required name.
+			/// @param node The node to search.
+			/// @param name The value of the 'name' attribute (case insensitive).
+			/// @param allowed If true ignore the <attribute> nodes rejected by is_allowed().
+			/// @param alias Alternative name, the first node matching any of the names is returned.
+			/// @return The <attribute> node (empty if not found).
+			static XML::Node attribute(const XML::Node &node, const char *name, bool allowed, const char *alias = nullptr);
+
+			/// @brief Call method on every child of node with the required tag name until it returns true.
+			/// @param node The parent node.
+			/// @param tagname The child tag name.
+			/// @param call The method to call.
+			/// @return true if the method has returned true.
+			static bool for_each(const XML::Node &node, const char *tagname, const std::function<bool(const XML::Node &child)> &call);
+
+		};
+
+	}
+
+ }
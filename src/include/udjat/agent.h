@@ -22,6 +22,8 @@
  #include <udjat/defs.h>
  #include <udjat/agent/abstract.h>
  #include <udjat/tools/converters.h>
+ #include <udjat/agent/index.h>
+ #include <type_traits>
 
  namespace Udjat {
 
@@ -32,6 +34,16 @@
 		/// @brief Agent value.
 		T value;
 
+		/// @brief Store numeric values on the history.
+		template <typename V>
+		inline typename std::enable_if<std::is_arithmetic<V>::value>::type store(const V &value) noexcept {
+			sample((double) value);
+		}
+
+		template <typename V>
+		inline typename std::enable_if<!std::is_arithmetic<V>::value>::type store(const V &) noexcept {
+		}
+
 	protected:
 
 		typedef Agent<T> super;
@@ -39,6 +51,9 @@
 		/// @brief Agent states.
 		std::vector<std::shared_ptr<State<T>>> states;
 
+		/// @brief Range index for states.
+		StateIndex<T> index;
+
 		void for_each(const std::function<void(const Abstract::State &state)> &method) const override {
 			for(auto state : states) {
 				method(*state);
@@ -49,6 +64,7 @@
 		std::shared_ptr<Abstract::State> StateFactory(const XML::Node &node, T value) {
 			auto state = std::make_shared<State<T>>(node, value);
 			states.push_back(state);
+			index.reset();
 			return state;
 		}
 
@@ -56,13 +72,14 @@
 		std::shared_ptr<Abstract::State> StateFactory(const XML::Node &node, T from, T to) {
 			auto state = std::make_shared<State<T>>(node, from, to);
 			states.push_back(state);
+			index.reset();
 			return state;
 		}
 
 		std::shared_ptr<Abstract::State> computeState() override {
-			for(auto state : states) {
-				if(state->compare(this->value))
-					return state;
+			int selected = index.find(states,name(),this->value);
+			if(selected >= 0) {
+				return states[selected];
 			}
 			return Abstract::Agent::computeState();
 		}
@@ -98,6 +115,8 @@
 
 		bool set(const T &value) {
 
+			store<T>(value);
+
 			if(value == this->value)
 				return updated(false);
 
@@ -131,6 +150,7 @@
 		std::shared_ptr<Abstract::State> StateFactory(const XML::Node &node) override {
 			auto state = std::make_shared<State<T>>(node);
 			states.push_back(state);
+			index.reset();
 			return state;
 		}
 
@@ -260,6 +280,8 @@
 
 		bool set(const bool value) {
 
+			sample(value ? 1 : 0);
+
 			if(value == this->value)
 				return updated(false);
 
@@ -22,10 +22,13 @@
  #include <udjat/tools/parse.h>
  #include <udjat/tools/object.h>
  #include <udjat/tools/value.h>
+ #include <udjat/tools/response.h>
  #include <udjat/agent/level.h>
  #include <udjat/agent/state.h>
  #include <mutex>
  #include <list>
+ #include <memory>
+ #include <atomic>
  #include <cstdint>
 
  namespace Udjat {
@@ -94,6 +97,33 @@
 #endif // !WIN32
 			} update;
 
+			/// @brief Value history.
+			class History;
+
+			/// @brief Value history (empty if not enabled).
+			std::shared_ptr<History> history;
+
+			/// @brief Serialized responses.
+			class Snapshot;
+
+			/// @brief Serialized responses, by mimetype (created on the first request).
+			mutable std::shared_ptr<Snapshot> snapshots;
+
+			/// @brief Get an unique value for the agent generation.
+			static uint64_t next_generation() noexcept;
+
+			/// @brief Generation of this agent subtree.
+			std::atomic<uint64_t> changes{next_generation()};
+
+			/// @brief Update the generation of this agent and its parents.
+			void touch() noexcept;
+
+			/// @brief OpenMetrics serialization state.
+			struct Metrics;
+
+			/// @brief Write this agent and its children to the OpenMetrics exposition.
+			void to_openmetrics(Metrics &metrics, const std::string &path) const;
+
 			struct {
 				/// @brief Active state.
 				std::shared_ptr<State> selected;
@@ -174,6 +204,9 @@
 			/// @brief Send event to listeners.
 			void notify(const Event event);
 
+			/// @brief Store value on the agent history, if enabled.
+			void sample(double value) noexcept;
+
 			/// @brief Set agent state.
 			/// @return true if the state has changed.
 			virtual bool set(std::shared_ptr<State> state);
@@ -416,6 +449,34 @@
 			/// @retval 0 The expiration time is not available.
 			virtual time_t expires() const noexcept;
 
+			/// @brief Get the agent generation.
+			/// @return Value changed on every value or state change of this agent or any of its children.
+			inline uint64_t generation() const noexcept {
+				return changes.load(std::memory_order_acquire);
+			}
+
+			/// @brief Get the entity tag for the agent properties.
+			/// @param mimetype The response mimetype.
+			/// @return Strong entity tag (ETag http header) for the current generation.
+			std::string etag(const MimeType mimetype) const;
+
+			/// @brief Get agent properties as a serialized response.
+			/// @details The serialized response is cached by mimetype until the next change on the agent generation.
+			/// @param response The response to fill.
+			/// @return true if the response was served from the cache.
+			bool snapshot(Udjat::Response &response) const;
+
+			/// @brief Write the agent and its children in the OpenMetrics text format.
+			/// @details Numeric agents are exported as gauges named after the agent path; the states of
+			/// every agent are exported on the 'udjat_agent_state' stateset and the level of the current
+			/// state on the 'udjat_agent_level' gauge.
+			/// @param out The output stream.
+			void to_openmetrics(std::ostream &out) const;
+
+			/// @brief Can the serialized properties be cached until the next generation change?
+			/// @details Override and return false on agents whose properties change without updating the agent.
+			virtual bool cacheable() const noexcept;
+
 		};
 	}
 
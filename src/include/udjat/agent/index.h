@@ -0,0 +1,200 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /// @brief Declares the state range index.
+
+ #pragma once
+
+ #include <udjat/defs.h>
+ #include <udjat/agent/state.h>
+ #include <udjat/tools/logger.h>
+ #include <type_traits>
+ #include <algorithm>
+ #include <memory>
+ #include <vector>
+ #include <mutex>
+
+ namespace Udjat {
+
+	/// @brief Sorted interval index for the range states of an agent.
+	/// @details The state boundaries split the values in points and open spans, each one mapped
+	/// to the first state (in declaration order) containing it; the lookup is a binary search
+	/// with the same result of the linear scan.
+	template <typename T>
+	class UDJAT_API StateIndex {
+	private:
+
+		/// @brief Sorted, distinct, state boundaries.
+		std::vector<T> bounds;
+
+		/// @brief State for each boundary value (-1 if none).
+		std::vector<int> points;
+
+		/// @brief State for the values between bounds[ix] and bounds[ix+1] (-1 if none).
+		std::vector<int> spans;
+
+		/// @brief Number of states indexed.
+		size_t count = (size_t) -1;
+
+		/// @brief Serialize the lazy build, the states could be computed from any thread.
+		std::mutex guard;
+
+		template <typename V>
+		static inline typename std::enable_if<std::is_integral<V>::value,bool>::type contiguous(const V to, const V from) noexcept {
+			return to < from && (V) (to + 1) == from;
+		}
+
+		template <typename V>
+		static inline typename std::enable_if<!std::is_integral<V>::value,bool>::type contiguous(const V, const V) noexcept {
+			return false;
+		}
+
+	public:
+
+		/// @brief Invalidate the index, it will be built again on the next lookup.
+		/// @details Call it whenever the state list is changed.
+		void reset() noexcept {
+			std::lock_guard<std::mutex> lock(guard);
+			count = (size_t) -1;
+		}
+
+		/// @brief Check if the index was built for the current state list.
+		template <typename S>
+		inline bool valid(const std::vector<std::shared_ptr<S>> &states) const noexcept {
+			return count == states.size();
+		}
+
+		/// @brief Build index, log overlapping ranges and gaps.
+		/// @param states The agent states.
+		/// @param name The agent name for the diagnostics.
+		template <typename S>
+		void build(const std::vector<std::shared_ptr<S>> &states, const char *name) {
+
+			bounds.clear();
+			points.clear();
+			spans.clear();
+			count = states.size();
+
+			for(const auto &state : states) {
+				bounds.push_back(state->lower());
+				bounds.push_back(state->upper());
+			}
+
+			std::sort(bounds.begin(),bounds.end());
+			bounds.erase(std::unique(bounds.begin(),bounds.end()),bounds.end());
+
+			points.assign(bounds.size(),-1);
+			spans.assign(bounds.size(),-1);
+
+			for(size_t ix = 0; ix < bounds.size(); ix++) {
+
+				for(size_t st = 0; st < states.size(); st++) {
+					if(states[st]->lower() <= bounds[ix] && states[st]->upper() >= bounds[ix]) {
+						points[ix] = (int) st;
+						break;
+					}
+				}
+
+				if(ix+1 < bounds.size()) {
+					for(size_t st = 0; st < states.size(); st++) {
+						if(states[st]->lower() <= bounds[ix] && states[st]->upper() >= bounds[ix+1]) {
+							spans[ix] = (int) st;
+							break;
+						}
+					}
+				}
+
+			}
+
+			// Diagnostics.
+			std::vector<size_t> order;
+			for(size_t st = 0; st < states.size(); st++) {
+				if(states[st]->lower() <= states[st]->upper()) {
+					order.push_back(st);
+				} else {
+					Logger::String{
+						"State '",states[st]->name(),"' has an empty range (",states[st]->value(),"), it will never be selected"
+					}.warning(name);
+				}
+			}
+
+			std::stable_sort(order.begin(),order.end(),[&states](size_t a, size_t b){
+				return states[a]->lower() < states[b]->lower();
+			});
+
+			for(size_t ix = 1; ix < order.size(); ix++) {
+
+				const auto &previous = states[order[ix-1]];
+				const auto &current = states[order[ix]];
+
+				if(current->lower() <= previous->upper()) {
+					Logger::String{
+						"State '",current->name(),"' (",current->value(),") overlaps '",
+						previous->name(),"' (",previous->value(),"), the first declared wins"
+					}.warning(name);
+				} else if(!contiguous(previous->upper(),current->lower())) {
+					Logger::String{
+						"No state for values between '",previous->name(),"' (",previous->value(),
+						") and '",current->name(),"' (",current->value(),")"
+					}.trace(name);
+				}
+
+			}
+
+		}
+
+		/// @brief Find state for value.
+		/// @return The state position (-1 if not found).
+		int find(const T value) const noexcept {
+
+			if(value != value) {
+				return -1;	// NaN is not in any range.
+			}
+
+			auto it = std::lower_bound(bounds.begin(),bounds.end(),value);
+			size_t ix = (size_t) (it - bounds.begin());
+
+			if(it != bounds.end() && !(value < *it) && !(*it < value)) {
+				return points[ix];
+			}
+
+			if(ix == 0 || it == bounds.end()) {
+				return -1;	// Out of range (or not comparable).
+			}
+
+			return spans[ix-1];
+
+		}
+
+		/// @brief Find state for value, build the index first if the state list has changed.
+		/// @param states The agent states.
+		/// @param name The agent name for the diagnostics.
+		/// @return The state position (-1 if not found).
+		template <typename S>
+		int find(const std::vector<std::shared_ptr<S>> &states, const char *name, const T value) {
+			std::lock_guard<std::mutex> lock(guard);
+			if(!valid(states)) {
+				build(states,name);
+			}
+			return find(value);
+		}
+
+	};
+
+ }
@@ -27,6 +27,7 @@
  #include <udjat/tools/percentage.h>
  #include <udjat/agent.h>	
  #include <udjat/agent/state.h>
+ #include <udjat/agent/index.h>
  #include <udjat/tools/value.h>
  #include <sstream>
  #include <iomanip>
@@ -48,6 +49,9 @@
 		/// @brief Agent states.
 		std::vector<std::shared_ptr<State<float>>> states;
 
+		/// @brief Range index for states.
+		StateIndex<float> index;
+
 		void for_each(const std::function<void(const Abstract::State &state)> &method) const override {
 			for(auto state : states) {
 				method(*state);
@@ -58,6 +62,7 @@
 		std::shared_ptr<Abstract::State> StateFactory(const XML::Node &node, Percentage value) {
 			auto state = std::make_shared<State<float>>(node, value);
 			states.push_back(state);
+			index.reset();
 			return state;
 		}
 
@@ -65,13 +70,14 @@
 		std::shared_ptr<Abstract::State> StateFactory(const XML::Node &node, Percentage from, Percentage to) {
 			auto state = std::make_shared<State<float>>(node, from, to);
 			states.push_back(state);
+			index.reset();
 			return state;
 		}
 
 		std::shared_ptr<Abstract::State> computeState() override {
-			for(auto state : states) {
-				if(state->compare((float) this->value))
-					return state;
+			int selected = index.find(states,name(),(float) this->value);
+			if(selected >= 0) {
+				return states[selected];
 			}
 			return Abstract::Agent::computeState();
 		}
@@ -100,6 +106,8 @@
 
 		bool set(const Percentage value) {
 
+			sample((float) value);
+
 			if(value == this->value)
 				return updated(false);
 
@@ -133,6 +141,7 @@
 		std::shared_ptr<Abstract::State> StateFactory(const XML::Node &node) override {
 			auto state = std::make_shared<State<float>>(node);
 			states.push_back(state);
+			index.reset();
 			return state;
 		}
 
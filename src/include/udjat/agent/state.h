@@ -239,6 +239,16 @@
 			return value >= from && value <= to;
 		}
 
+		/// @brief Minimum value for state activation.
+		inline T lower() const noexcept {
+			return from;
+		}
+
+		/// @brief Maximum value for state activation.
+		inline T upper() const noexcept {
+			return to;
+		}
+
 		inline bool operator==(const T value) const noexcept {
 			return value == from && from == to;
 		}
@@ -21,6 +21,8 @@
 
  #include <udjat/defs.h>
  #include <memory>
+ #include <string>
+ #include <vector>
  #include <udjat/tools/object.h>
  #include <udjat/tools/xml.h>
  #include <udjat/tools/activatable.h>
@@ -36,6 +38,9 @@
 
 		typedef Alert super;
 
+		/// @brief Persistent queue for rendered payloads.
+		class Spool;
+
 		/// @brief Clear activation parameters.
 		/// @param next Timestamp for next activation (0 to deactivate).
 		virtual void reset(time_t next = 0) noexcept;
@@ -70,6 +75,17 @@
 		/// @return 0 on success, error code when failed.
 		virtual int emit() = 0;
 
+		/// @brief Emit the due alerts for the same destination at once.
+		/// @param alerts The due alerts, including this one.
+		/// @return 0 on success, error code when failed (for every alert), -ENOTSUP to emit one by one.
+		virtual int emit(const std::vector<Alert *> &alerts);
+
+		/// @brief Get the alert destination.
+		/// @details Alerts with the same destination share the concurrency and rate limits
+		/// and can be emitted in batches.
+		/// @return The destination id (empty for no limits).
+		virtual std::string destination() const;
+
 		void failed(const char *message) noexcept;
 		void success() noexcept;
 
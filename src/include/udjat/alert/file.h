@@ -32,6 +32,8 @@
 
 		const char *filename = "";	///< @brief File to update.
 		time_t maxage = 86400;		///< @brief Maximum age for the file.
+		size_t maxsize = 0;			///< @brief Maximum size for the file (0 = no limit).
+		bool spool = false;			///< @brief Store payloads on the persistent spool instead of writing directly.
 
 		struct Payload {
 			const char *tmpl;		///< @brief Template to payload.
@@ -44,8 +46,20 @@
 
 		void reset(time_t next) noexcept override;
 
+		/// @brief Get the expanded file name.
+		String path() const;
+
+		/// @brief Append payloads to the file, one per line.
+		void write(const std::vector<std::string> &payloads);
+
 		int emit() override;
 
+		/// @brief Append the payloads of the alerts with the same filename in a single write.
+		int emit(const std::vector<Alert *> &alerts) override;
+
+		/// @brief The file template, alerts to the same file are batched.
+		std::string destination() const override;
+
 	public:
 
 		FileAlert(const char *name, const char *f, const char *p = "") : Alert{name}, filename{f}, payload{p} {
@@ -32,6 +32,7 @@
 
 		class Controller;
 		friend class Controller;
+		friend class MainLoop;
 
 		struct Listener {
 			const void *id;
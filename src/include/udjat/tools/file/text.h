@@ -21,6 +21,11 @@
 
 #include <udjat/defs.h>
 #include <udjat/tools/file/path.h>
+#include <iterator>
+
+#if __cplusplus >= 201703L
+	#include <string_view>
+#endif // __cplusplus >= 201703L
 
 namespace Udjat {
 
@@ -84,6 +89,61 @@ namespace Udjat {
 
 			};
 
+#if __cplusplus >= 201703L
+			/// @brief Non allocating line iterator, the lines are views on the text.
+			class UDJAT_API Lines {
+			public:
+
+				class UDJAT_API Iterator {
+				private:
+					friend class Lines;
+
+					const char *ptr;		///< @brief Start of the current line.
+					const char *eol;		///< @brief End of the current line.
+					const char *limit;		///< @brief End of the text.
+					char delimiter;
+
+					Iterator(const char *ptr, const char *limit, char delimiter) noexcept;
+
+				public:
+					using iterator_category = std::forward_iterator_tag;
+					using value_type        = std::string_view;
+
+					inline std::string_view operator*() const noexcept {
+						return std::string_view{ptr,(size_t) (eol-ptr)};
+					}
+
+					// Prefix increment
+					Iterator& operator++() noexcept;
+
+					// Postfix increment
+					Iterator operator++(int) noexcept;
+
+					friend bool operator== (const Iterator& a, const Iterator& b) {
+						return a.ptr == b.ptr;
+					};
+
+					friend bool operator!= (const Iterator& a, const Iterator& b) {
+						return a.ptr != b.ptr;
+					};
+
+				};
+
+				/// @brief Iterate over the records of a text, it doesn't need to be nul terminated.
+				constexpr Lines(const char *t, size_t l, char d = '\n') : text{t}, length{l}, delimiter{d} {
+				}
+
+				Iterator begin() const noexcept;
+				Iterator end() const noexcept;
+
+			private:
+				const char *text;
+				size_t length;
+				char delimiter;
+
+			};
+#endif // __cplusplus >= 201703L
+
 			Text(int fd, ssize_t length = -1);
 			Text(const char *filename);
 			Text(const std::string &filename) : Text(filename.c_str()) {
@@ -95,23 +155,40 @@ namespace Udjat {
 				return this->contents;
 			}
 
+			inline size_t size() const noexcept {
+				return this->length;
+			}
+
+#if __cplusplus >= 201703L
+			/// @brief Get the records of the file contents without copying them.
+			/// @param delimiter The record delimiter.
+			inline Lines lines(char delimiter = '\n') const noexcept {
+				return Lines{contents,(contents ? length : 0),delimiter};
+			}
+#endif // __cplusplus >= 201703L
+
 			const Iterator begin() const noexcept;
 			const Iterator end() const noexcept;
 
 			Text & set(const char *contents);
 
+			/// @brief Replace contents.
+			/// @param contents The new contents (doesn't need to be nul terminated).
+			/// @param length The length of the new contents.
+			Text & set(const char *contents, size_t length);
+
 			inline Text & set(const std::string &contents) {
-				return set(contents.c_str());
+				return set(contents.c_str(),contents.size());
 			}
 
 			static void for_each(const char *text, std::function<void (const std::string &line)> call);
 
-			inline void for_each(std::function<void (const std::string &line)> call) const {
-				for_each(contents,call);
-			}
+			/// @brief Call for every line, like for_each(contents) but limited to the content length.
+			/// @details A trailing newline (or an empty text) yields a final empty line.
+			void for_each(std::function<void (const std::string &line)> call) const;
 
 			inline void forEach(std::function<void (const std::string &line)> call) const {
-				for_each(contents,call);
+				for_each(call);
 			}
 
 			/// @brief Expand ${} macros.
@@ -44,9 +44,11 @@
 
 			/// @brief Build a watcher from path.
 			/// @param path The file or directory to watch.
-			Watcher(const char *pathname);
+			/// @param recursive If true, watch the subdirectories of a directory too.
+			Watcher(const char *pathname, bool recursive = false);
 
 			/// @brief Build a watcher from XML definition.
+			/// @details Set attribute 'recursive' to 'true' to watch the subdirectories of a directory.
 			Watcher(const XML::Node &node, const char *attrname = "path");
 
 			virtual ~Watcher();
@@ -62,7 +64,11 @@
 			/// @brief The file/directory path.
 			const char *pathname;
 
+			/// @brief Watch subdirectories.
+			bool recursive = false;
+
 			/// @brief Launch file event.
+			/// @param filename The file name; for recursive watchers the path relative to the watched directory.
 			virtual void updated(const Event event, const char *filename);
 
 		private:
@@ -60,6 +60,12 @@
 
 		form_urlencoded,		///> @brief application/x-www-form-urlencoded
 
+		// https://github.com/prometheus/OpenMetrics/blob/main/specification/OpenMetrics.md
+		openmetrics,			///> @brief application/openmetrics-text; version=1.0.0; charset=utf-8
+
+		// https://www.rfc-editor.org/rfc/rfc8949
+		cbor,					///> @brief application/cbor
+
 
 	
 	};
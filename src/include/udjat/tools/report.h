@@ -25,78 +25,94 @@
  #include <string>
  #include <ostream>
  #include <vector>
- #include <list>
  #include <cstdarg>
 
  namespace Udjat {
 
 	/// @brief Report with fixed columns.
+	/// @details Cells are stored by column, with the type tags and the contents in separated vectors;
+	/// string cells are kept in a single nul terminated buffer shared by all columns, so appending
+	/// a cell doesn't need a heap allocation (besides the vector growth, see reserve()).
 	class UDJAT_API Report {
 	private:
 
-		struct UDJAT_API Cell {
-			Value::Type type = Value::Undefined;
-			union {
-				time_t timestamp;
-				int sig;
-				unsigned int unsig;
-				double dbl;
-				void *ptr = nullptr;
-			} data;
-
-			Cell();
-			~Cell();
+		/// @brief Cell contents.
+		union Data {
+			time_t timestamp;
+			long long sig;
+			unsigned long long unsig;
+			double dbl;
+			size_t offset;	///< @brief Offset of the string in the string buffer.
+		};
 
-			void clear() noexcept;
+		/// @brief Report column.
+		struct Column {
+			std::string name;
+			std::vector<Value::Type> types;
+			std::vector<Data> data;
 
-			void set(const char *value);
-			inline void set(const std::string &value) {
-				return set(value.c_str());
+			Column(const char *n) : name{n} {
 			}
 
-			void set(const Value &value);
-
-			void set(const short value);
-			void set(const unsigned short value);
-			void set(const int value);
-			void set(const unsigned int value);
-			void set(const TimeStamp &value);
-			void set(const bool value);
-			void set(const float value);
-			void set(const double value);
-
-			template <typename T>
-			void set(const T &value) {
-				return this->set(std::to_string(value));
+			inline size_t size() const noexcept {
+				return data.size();
 			}
-
-			void serialize(std::ostream &out) const;
-
 		};
 
 		struct {
 			std::string caption;
 		} field;
 
-#if __cplusplus >= 201703L
-		std::list<Cell> cells;
-#else
-                class Cells : public std::list<Cell> {
-                public:
-                  Cells() : std::list<Cell>() {
-                  }
-
-		  inline Cell & emplace_back() {
-		    std::list<Cell>::emplace_back();
-		    return std::list<Cell>::back();
-		  }
-                  
-                } cells;
-#endif
-		std::vector<std::string> headers;
+		/// @brief The report columns.
+		std::vector<Column> table;
+
+		/// @brief The string cells.
+		std::string strings;
+
+		/// @brief Number of cells in the report.
+		size_t cells = 0;
 
 		void set_headers(const char *column_name, va_list args);
 
+		/// @brief Get the column for the next cell.
+		Column & next();
+
+		/// @brief Check if a row with the number of cells can be appended.
+		void check_row(size_t length) const;
+
+		void store(Value::Type type, Data data);
+
+		// The store() overloads and check_row() are called from the inline push_back() and append()
+		// templates, they are part of the library ABI: don't change them without a soname bump.
+
+		void store(const char *value);
+		inline void store(const std::string &value) {
+			store(value.c_str());
+		}
+
+		void store(const Value &value);
+
+		void store(const short value);
+		void store(const unsigned short value);
+		void store(const int value);
+		void store(const unsigned int value);
+		void store(const long value);
+		void store(const unsigned long value);
+		void store(const long long value);
+		void store(const unsigned long long value);
+		void store(const TimeStamp &value);
+		void store(const bool value);
+		void store(const float value);
+		void store(const double value);
+
+		template <typename T>
+		void store(const T &value) {
+			store(std::to_string(value));
+		}
+
+		/// @brief Write cell contents.
+		void write(std::ostream &out, const Column &column, size_t row) const;
+
 	public:
 
 		Report(const char *column_name, va_list args) {
@@ -117,11 +133,38 @@
 			return field.caption.c_str();
 		}
 
+		/// @brief Get the number of columns.
+		inline size_t columns() const noexcept {
+			return table.size();
+		}
+
+		/// @brief Get the number of rows (including the incomplete last one).
+		size_t rows() const noexcept;
+
+		inline bool empty() const noexcept {
+			return cells == 0;
+		}
+
+		/// @brief Reserve storage.
+		/// @param rows The expected number of rows.
+		/// @param length The expected length of the string cells in each row.
+		void reserve(size_t rows, size_t length = 0);
+
 		Report & push_back(const Value &value);
 
 		template <typename T>
 		Report & push_back(const T &value) {
-			cells.emplace_back().set(value);
+			store(value);
+			return *this;
+		}
+
+		/// @brief Append a full row.
+		/// @param values One value for each column.
+		template <typename... Args>
+		Report & append(const Args &... values) {
+			check_row(sizeof...(Args));
+			int expand[] = { 0, (store(values), 0)... };
+			(void) expand;
 			return *this;
 		}
 
@@ -131,6 +174,7 @@
 		void to_yaml(std::ostream &out, size_t left_margin = 0) const;
 		void to_sh(std::ostream &stream) const;
 		void to_csv(std::ostream &out, char delimiter = ',') const;
+		void to_cbor(std::ostream &out) const;
 
 	};
 
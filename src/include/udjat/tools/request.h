@@ -99,6 +99,18 @@
 		/// @retval false The cache must be refreshed.
 		virtual bool cached(const TimeStamp &timestamp) const;
 
+		/// @brief Check the entity tag against the If-None-Match header.
+		/// @param etag The current entity tag.
+		/// @return True if the etag matches any of the tags in the If-None-Match header.
+		bool match(const char *etag) const;
+
+		/// @brief Evaluate the conditional request headers.
+		/// @details If-None-Match has precedence, If-Modified-Since is checked only when it is not present (RFC 7232, section 6).
+		/// @param timestamp Current response timestamp (0 if not available).
+		/// @param etag Current entity tag (empty if not available).
+		/// @return True if the response can be sent as 'not modified'.
+		bool not_modified(const TimeStamp &timestamp, const char *etag) const;
+
 		/// @brief Get query.
 		/// @param def The value to return if the string dont have query.
 		/// @return The query value or 'def'.
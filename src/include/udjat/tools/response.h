@@ -22,6 +22,7 @@
  #include <udjat/defs.h>
  #include <udjat/tools/value.h>
  #include <string>
+ #include <memory>
  #include <map>
 
  namespace Udjat {
@@ -67,6 +68,12 @@
 			size_t count = 0; ///< @brief The item count (for X-Total-Count http header)
 		} range;
 
+		/// @brief The entity tag (ETag http header, empty if not available).
+		std::string entity_tag;
+
+		/// @brief Pre-serialized response (replaces the value serialization when set).
+		std::shared_ptr<const std::string> contents;
+
 	public:
 		Response(const MimeType m = MimeType::json) : mimetype(m) {
 		}
@@ -184,6 +191,23 @@
 			return (time_t) timestamp.expires;
 		}
 
+		/// @brief Set the entity tag (ETag http header).
+		inline void etag(const std::string &tag) {
+			entity_tag = tag;
+		}
+
+		/// @brief Get the entity tag.
+		/// @return The entity tag ("" if not available).
+		inline const char * etag() const noexcept {
+			return entity_tag.c_str();
+		}
+
+		/// @brief Set the pre-serialized response.
+		/// @param value The serialized response, will be sent by serialize() instead of the response values.
+		inline void snapshot(std::shared_ptr<const std::string> value) noexcept {
+			contents = value;
+		}
+
 	};
 
  }
@@ -25,13 +25,73 @@
  #include <udjat/tools/url.h>
  #include <sys/ioctl.h>
  #include <system_error>
+ #include <memory>
+ #include <string>
+ #include <vector>
+ #include <deque>
+ #include <mutex>
 
  namespace Udjat {
 
 	class UDJAT_API Socket : public MainLoop::Handler {
+	public:
+
+		/// @brief Socket timeouts, in milliseconds (0 to disable).
+		struct Timeouts {
+			unsigned long connect = 0;	///< @brief Maximum time to establish the connection.
+			unsigned long read = 0;		///< @brief Maximum time waiting for incoming data after sending.
+			unsigned long idle = 0;		///< @brief Maximum time without any traffic.
+		};
+
+		/// @brief Output queue limits, in bytes.
+		struct Watermarks {
+			size_t high = 0;			///< @brief Pause the producers when the queued data reaches this size (0 to disable).
+			size_t low = 0;				///< @brief Resume the producers when the queued data drops to this size.
+		};
+
 	private:
 		bool connecting = false;
-	
+
+		class Watchdog;
+		Watchdog *watchdog = nullptr;
+
+		/// @brief Refcounted output buffer.
+		struct Buffer {
+			std::shared_ptr<const std::string> data;
+			size_t offset = 0;
+		};
+
+		/// @brief Serialize the output queue, write() can be called from any thread.
+		mutable std::recursive_mutex guard;
+
+		/// @brief Reference for the messages posted to the main loop, expires with the socket.
+		std::shared_ptr<Socket *> self{std::make_shared<Socket *>(this)};
+
+		struct {
+			std::deque<Buffer> queue;
+			size_t length = 0;			///< @brief Bytes waiting to be sent.
+			bool paused = false;		///< @brief Producers were paused by the high watermark.
+			Watermarks watermarks;
+		} output;
+
+		struct {
+			std::vector<char> buffer;
+			size_t offset = 0;			///< @brief Start of the unread data.
+			size_t length = 0;			///< @brief End of the unread data.
+			size_t limit = 1048576;		///< @brief Stop reading when the unread data reaches this size.
+		} input;
+
+		/// @brief Update the poll events from the socket state.
+		void update() noexcept;
+
+		/// @brief Read available data to the input buffer.
+		/// @return false if the socket was closed.
+		bool receive();
+
+		/// @brief Send queued data.
+		/// @return false if the socket was closed.
+		bool send();
+
 	protected:
 		void handle_event(const Event event) override;
 
@@ -40,12 +100,46 @@
 		virtual void handle_connect(int error_code);
 		
 		virtual void handle_disconnect();
+
+		/// @brief New data on the input buffer, get it with read().
 		virtual void handle_read_ok();
+
+		/// @brief The output queue is below the low watermark, producers can resume.
 		virtual void handle_write_ok();
+
 		virtual void handle_error(int code);
 
+		/// @brief Get the unread data.
+		inline const char * data() const noexcept {
+			return input.buffer.data() + input.offset;
+		}
+
+		/// @brief Get the length of the unread data.
+		inline size_t available() const noexcept {
+			return input.length - input.offset;
+		}
+
+		/// @brief Remove data from the input buffer.
+		void consume(size_t length) noexcept;
+
+		/// @brief Get the next delimited frame from the input buffer.
+		/// @param frame String to receive the frame, without the delimiter.
+		/// @param delimiter The frame delimiter.
+		/// @return true if a full frame was extracted.
+		/// @exception std::system_error EMSGSIZE if the input buffer limit was reached without a delimiter.
+		bool read(std::string &frame, const char *delimiter = "\n");
+
+		/// @brief Get the next length-prefixed frame from the input buffer.
+		/// @param frame String to receive the frame, without the prefix.
+		/// @param prefix Size of the big endian length prefix (1, 2 or 4 bytes).
+		/// @return true if a full frame was extracted.
+		bool read(std::string &frame, size_t prefix);
+
 	public:
 
+		using MainLoop::Handler::set;
+		using MainLoop::Handler::read;
+
 		/// @brief Connect to URL
 		/// @param url URL to connect
 		Socket(const URL &url, unsigned int seconds = 0);
@@ -81,6 +175,36 @@
 			return wait_for_connection(values.fd, seconds);
 		}
 
+		/// @brief Set timeouts.
+		void set(const Timeouts &timeouts);
+
+		/// @brief Set output queue limits.
+		void set(const Watermarks &watermarks);
+
+		/// @brief Set the input buffer limit, reading stops when the unread data reaches it.
+		inline void limit(size_t length) noexcept {
+			input.limit = length;
+		}
+
+		/// @brief Queue data for sending, can be called from any thread.
+		/// @details The socket is flushed and its events updated from the main loop.
+		/// @param data The data to send, shared with the queue until sent.
+		/// @return false if the output queue has reached the high watermark, wait for handle_write_ok() before sending more.
+		bool write(const std::shared_ptr<const std::string> &data);
+
+		/// @brief Queue a copy of data for sending.
+		bool write(const void *data, size_t length);
+
+		inline bool write(const std::string &data) {
+			return write(std::make_shared<const std::string>(data));
+		}
+
+		/// @brief Get the number of bytes waiting to be sent.
+		size_t pending() const noexcept;
+
+		/// @brief Are the producers paused by the high watermark?
+		bool paused() const noexcept;
+
 		template <typename T>
 		inline void ioctl(unsigned long op, T &val) const {
 			if(::ioctl(fd(), op, (caddr_t)&val) < 0) {
@@ -88,6 +212,15 @@
 			}
 		}
 
+	protected:
+
+		// Appended to keep the vtable layout of the older virtual methods.
+
+		/// @brief The output queue has reached the high watermark, producers should wait for handle_write_ok().
+		virtual void handle_write_paused();
+
+		/// @brief Read or idle timeout, the default closes the socket and calls handle_error(ETIMEDOUT).
+		virtual void handle_timeout();
 
 	};
 
@@ -21,10 +21,15 @@
 
 #include <udjat/defs.h>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <functional>
 #include <udjat/tools/string.h>
 
+#if !defined(_WIN32) && __cplusplus >= 201703L
+	#include <string_view>
+#endif
+
 namespace Udjat {
 
 	namespace System {
@@ -33,6 +38,93 @@ namespace Udjat {
 		/// @return The CPE for this system.
 		UDJAT_API String cpe();
 
+#if !defined(_WIN32) && __cplusplus >= 201703L
+
+		/// @brief Reader for /proc and /sys files sampled periodically.
+		/// @details Keeps the file open and reads it with pread() into a reusable buffer; the values are
+		/// parsed in place, keys are located through an index built on the first read and
+		/// revalidated on every lookup, so refreshing the contents doesn't allocate.
+		class UDJAT_API ProcFile {
+		private:
+
+			int fd = -1;
+
+			/// @brief The key/value delimiter (' ' for any blank).
+			char separator;
+
+			/// @brief File contents, nul terminated.
+			std::vector<char> buffer;
+
+			/// @brief Length of the contents.
+			size_t length = 0;
+
+			/// @brief Keys from the last scan, the index views point here.
+			std::string keys;
+
+			/// @brief Key offsets from the last scan.
+			std::unordered_map<std::string_view,size_t> index;
+
+			/// @brief True if the contents changed after the last scan.
+			bool stale = true;
+
+			/// @brief Build key index.
+			void scan();
+
+			/// @brief Get the offset of the value for key.
+			/// @return The value offset (std::string::npos if not found).
+			size_t locate(const char *key);
+
+		public:
+			/// @brief Open file.
+			/// @param filename The file path.
+			/// @param separator The key/value delimiter (' ' for files like /proc/stat).
+			ProcFile(const char *filename, const char separator = ':');
+			ProcFile(const ProcFile &) = delete;
+			ProcFile & operator=(const ProcFile &) = delete;
+
+			~ProcFile();
+
+			/// @brief Read file contents again.
+			ProcFile & refresh();
+
+			/// @brief The file contents from the last refresh.
+			inline const char * c_str() const noexcept {
+				return buffer.data();
+			}
+
+			inline size_t size() const noexcept {
+				return length;
+			}
+
+			/// @brief Get value text, up to the end of line.
+			/// @param key The key (case sensitive, nullptr for the first line of files without keys).
+			/// @return The value (empty if not found).
+			std::string_view get(const char *key);
+
+			inline std::string_view operator[](const char *key) {
+				return get(key);
+			}
+
+			/// @brief Get the first number of a value (units like 'kB' are ignored).
+			unsigned long long as_ull(const char *key = nullptr, unsigned long long def = 0);
+
+			/// @brief Get the first number of a value.
+			long long as_ll(const char *key = nullptr, long long def = 0);
+
+			/// @brief Get the first number of a value.
+			double as_double(const char *key = nullptr, double def = 0);
+
+			/// @brief Get the numbers of a value (like the 'cpu' lines from /proc/stat).
+			/// @param key The key.
+			/// @param values Array for the values.
+			/// @param count Array length.
+			/// @return The number of values parsed.
+			size_t get(const char *key, unsigned long long *values, size_t count);
+
+		};
+
+#endif // !_WIN32 && __cplusplus >= 201703L
+
 		namespace Config {
 
 			/// @brief SysConfig file parser.
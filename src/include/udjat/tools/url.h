@@ -40,6 +40,11 @@
  #include <udjat/tools/file/handler.h>
  #include <udjat/tools/xml.h>
  #include <memory>
+ #include <vector>
+
+ #if __cplusplus >= 201703L
+	#include <string_view>
+ #endif // __cplusplus >= 201703L
 
  namespace Udjat {
 
@@ -48,6 +53,74 @@
 
 		class Handler;
 
+		class Components;
+
+#if __cplusplus >= 201703L
+		/// @brief URL components, parsed once.
+		/// @details Keeps a copy of the parsed URL and the offsets of each component, the accessors
+		/// return views on this copy. Absent components are returned as a default (null) view.
+		class UDJAT_API Components {
+		private:
+
+			/// @brief Component offset on the URL text.
+			struct Span {
+				size_t offset = std::string::npos;	///< @brief Offset of the component (npos if absent).
+				size_t length = 0;
+			};
+
+			enum : uint8_t {
+				Scheme,
+				Host,
+				Port,
+				Query,
+				Fragment,
+				Count
+			};
+
+			std::string text;
+
+			Span spans[Count];
+
+			/// @brief Path segments.
+			std::vector<Span> paths;
+
+			std::string_view view(const Span &span) const noexcept;
+
+		public:
+
+			/// @brief Parse URL.
+			/// @param url The URL to parse (an empty string has no components).
+			Components(const std::string &url);
+
+			/// @brief The parsed URL.
+			inline const std::string & str() const noexcept {
+				return text;
+			}
+
+			inline bool operator==(const std::string &url) const noexcept {
+				return text == url;
+			}
+
+			std::string_view scheme() const noexcept;
+			std::string_view hostname() const noexcept;
+			std::string_view port() const noexcept;
+			std::string_view query() const noexcept;
+			std::string_view fragment() const noexcept;
+
+			/// @brief Get the number of path segments.
+			inline size_t segments() const noexcept {
+				return paths.size();
+			}
+
+			/// @brief Get path segment.
+			std::string_view segment(size_t index) const noexcept;
+
+			/// @brief Get path, with every segment prefixed by '/'.
+			std::string path() const;
+
+		};
+#endif // __cplusplus >= 201703L
+
 		URL() = default;
 
 		URL(const char *str) : Udjat::String{str} {
@@ -100,14 +173,23 @@
 
 		inline URL & operator = (const char *path) {
 			String::operator=(path);
+			parsed.reset();
 			return *this;
 		}
 
 		inline URL & operator = (const std::string &path) {
 			String::operator=(path.c_str());
+			parsed.reset();
 			return *this;
 		}
 
+#if __cplusplus >= 201703L
+		/// @brief Get the parsed components.
+		/// @details The URL is parsed on the first call; the result is reused until the URL text changes.
+		/// @return The components of the current URL text.
+		std::shared_ptr<const Components> components() const;
+#endif // __cplusplus >= 201703L
+
 		/// @brief Connect to host
 		/// @return A non-blocking, connected socket.
 		int connect(unsigned int seconds = 0);
@@ -211,6 +293,12 @@
 		static bool progress_to_console(const char *url,uint64_t current, uint64_t total) noexcept;
 
 		static bool progress_to_console(const char *prefix, const char *url, uint64_t current, uint64_t total) noexcept;
+
+	private:
+
+		/// @brief Cached components, checked against the URL text on every use.
+		mutable std::shared_ptr<const Components> parsed;
+
 	};
 
  }
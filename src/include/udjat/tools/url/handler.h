@@ -85,6 +85,14 @@
 		private:
 			const char *name;
 
+		protected:
+
+			/// @brief Maximum number of idle handlers kept for each URL, 0 disables the handler pool.
+			/// @details Defaults to the 'url-handler-pool' configuration value for the factory name;
+			/// set it on the constructor to reuse handlers (keep-alive connections, open files)
+			/// on repeated requests to the same URL. Only handlers whose reset() returns true are reused.
+			size_t pool_size = 0;
+
 		public:
 			Factory(const char *name, const char *description = nullptr);
 			virtual ~Factory();
@@ -95,6 +103,62 @@
 
 			virtual std::shared_ptr<Handler> HandlerFactory(const URL &url) const = 0;
 
+			/// @brief Get handler for URL, reusing an idle one when the pool is enabled.
+			/// @param url The URL to handle.
+			/// @return The handler, returned to the pool when released.
+			std::shared_ptr<Handler> handler(const URL &url) const;
+
+		};
+
+		/// @brief Destination for the response contents.
+		/// @details Receives the response without intermediate buffers; derive it to write into
+		/// a caller provided buffer, a file descriptor or an incremental parser.
+		class UDJAT_API Sink {
+		public:
+			virtual ~Sink();
+
+			/// @brief Set the response length, called before the contents when the length is known.
+			/// @param total The response length.
+			virtual void allocate(uint64_t total);
+
+			/// @brief Write response block.
+			/// @param offset The offset of the block in the response.
+			/// @param data The block contents.
+			/// @param length The block length.
+			/// @return true to cancel the operation.
+			virtual bool write(uint64_t offset, const void *data, size_t length) = 0;
+
+			/// @brief Notify progress of data copied directly to the descriptor.
+			/// @return true to cancel the operation.
+			virtual bool progress(uint64_t current, uint64_t total);
+
+			/// @brief Get the file descriptor for direct copy.
+			/// @details When valid, local handlers can copy the contents in kernel (copy_file_range/sendfile),
+			/// starting at offset 0, instead of calling write().
+			/// @return The file descriptor (-1 if the sink has no descriptor).
+			virtual int descriptor() const noexcept;
+
+		};
+
+		/// @brief Sink writing to a caller provided buffer.
+		class UDJAT_API BufferSink : public Sink {
+		private:
+			void *buffer;
+			size_t size;
+			size_t used = 0;
+
+		public:
+			BufferSink(void *buffer, size_t size) : buffer{buffer}, size{size} {
+			}
+
+			/// @brief Get the number of bytes written.
+			inline size_t length() const noexcept {
+				return used;
+			}
+
+			/// @exception std::system_error ENOBUFS if the response doesn't fit in the buffer.
+			bool write(uint64_t offset, const void *data, size_t length) override;
+
 		};
 
 		/// @brief Perform request.
@@ -148,6 +212,22 @@
 		/// @brief Download or update a file with progress, setting the last modified time to the value sent by the host.
 		bool get(const char *filename, const HTTP::Method method = HTTP::Get, const char *payload = "");
 
+		/// @brief Reset the request state before reusing a pooled handler.
+		/// @details The base class has no storage for headers or credentials, so it clears the status
+		/// and refuses the reuse. Handlers from factories with a pool should override it, clearing
+		/// their own request state (headers, credentials) and keeping the reusable resources.
+		/// @return true if the handler can be reused.
+		virtual bool reset();
+
+		/// @brief Perform request, sending the response to sink.
+		/// @details Declared after the other virtuals to keep their slots; derived classes
+		/// overriding perform() should add 'using URL::Handler::perform' to keep this overload visible.
+		/// @param method The HTTP method to use.
+		/// @param payload The payload to send.
+		/// @param sink The response destination.
+		/// @return HTTP return code.
+		virtual int perform(const HTTP::Method method, const char *payload, Sink &sink);
+
 	};
 	
  }
@@ -63,6 +63,9 @@
 
 		class Getter;
 		friend class Getter;
+
+		class Decoder;
+		friend class Decoder;
 	
 		Type type = Undefined;
 
@@ -272,6 +275,16 @@
 		/// @brief Serialize arrays to csv
 		void to_csv(std::ostream &out, char delimiter = ',') const;
 
+		/// @brief Serialize to CBOR (RFC 8949).
+		/// @details Types without a CBOR equivalent are tagged, see private/cbor.h.
+		void to_cbor(std::ostream &out) const;
+
+		/// @brief Load value from CBOR (RFC 8949).
+		/// @param data The encoded data.
+		/// @param length The length of the encoded data.
+		/// @return The number of bytes used.
+		size_t from_cbor(const void *data, size_t length);
+
 	};
 
  };
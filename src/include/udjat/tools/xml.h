@@ -63,6 +63,7 @@
 		public:
 			Document(const char *filename);
 			Document(const char *data, size_t size);
+			~Document();
 
 			/// Copy document node to the given node.
 			/// @param node Node to copy the document root.
@@ -28,6 +28,7 @@
  #include <config.h>
  #include <udjat/agent/abstract.h>
  #include <private/agent.h>
+ #include <private/history.h>
  #include <cstring>
  #include <udjat/tools/xml.h>
  #include <udjat/tools/configuration.h>
@@ -78,6 +79,8 @@ namespace Udjat {
 		if(delay)
 			update.next = time(nullptr) + delay;
 
+		history = History::Factory(node);
+
 #ifndef _WIN32
 		{
 			// Check for signal based update.
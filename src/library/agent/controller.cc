@@ -394,19 +394,32 @@ namespace Udjat {
 					if(timestamp) {
 						debug("last-modified: ",TimeStamp{timestamp});
 						response.last_modified(timestamp);
-						if(request.cached(timestamp)) {
+					}
+
+					if(agent->update.next) {
+						response.expires(agent->update.next);
+					}
+
+					if(agent->cacheable()) {
+
+						std::string etag{agent->etag((MimeType) response)};
+						response.etag(etag);
+
+						if(request.not_modified(timestamp,etag.c_str())) {
 							response.not_modified(true);
 							return 0;
 						}
-					}
 
-					agent->getProperties(response);
+					} else if(request.cached(timestamp)) {
+
+						// No entity tag, the generation doesn't track every change of this agent.
+						response.not_modified(true);
+						return 0;
 
-					if(agent->update.next) {
-						response.expires(agent->update.next);
 					}
 
-					response.message(agent->state()->to_string().c_str());
+					// Use the serialized response when the agent was not changed.
+					agent->snapshot(response);
 
 					return 0;
 				});
@@ -33,6 +33,11 @@
 namespace Udjat {
 
 	void Abstract::Agent::notify(const Event event) {
+
+		if(event & (VALUE_CHANGED|STATE_CHANGED)) {
+			touch();
+		}
+
 		lock_guard<std::recursive_mutex> lock(guard);
 		for(Listener &listener : listeners) {
 			if((listener.event & event) != 0) {
@@ -0,0 +1,182 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements the agent value history.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <private/history.h>
+ #include <udjat/tools/configuration.h>
+ #include <udjat/tools/timestamp.h>
+ #include <udjat/tools/xml.h>
+ #include <cstdlib>
+ #include <cstring>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	void Abstract::Agent::History::Bucket::add(double value) noexcept {
+		if(!count) {
+			min = max = value;
+		} else if(value < min) {
+			min = value;
+		} else if(value > max) {
+			max = value;
+		}
+		sum += value;
+		count++;
+	}
+
+	void Abstract::Agent::History::Level::add(time_t timestamp, double value) noexcept {
+
+		time_t start = timestamp - (timestamp % interval);
+
+		if(bucket.count && bucket.timestamp != start) {
+			// Close bucket.
+			buckets.push(bucket);
+			bucket = Bucket{};
+		}
+
+		if(!bucket.count) {
+			bucket.timestamp = start;
+		}
+
+		bucket.add(value);
+		current.push(bucket);
+
+	}
+
+	void Abstract::Agent::History::Level::append(Value &value, const Bucket &bucket) {
+		Value &row = value.append(Value::Object);
+		row["timestamp"] = TimeStamp{bucket.timestamp};
+		row["min"] = bucket.min;
+		row["avg"] = bucket.sum / bucket.count;
+		row["max"] = bucket.max;
+		row["count"] = (unsigned int) bucket.count;
+	}
+
+	void Abstract::Agent::History::Level::get(time_t from, Value &value) const {
+
+		time_t last = 0;
+
+		buckets.for_each([&](const Bucket &bucket){
+			if(bucket.count && (bucket.timestamp + interval) > from) {
+				append(value,bucket);
+				last = bucket.timestamp;
+			}
+			return false;
+		});
+
+		current.for_each([&](const Bucket &bucket){
+			// The open bucket could be already closed if the writer is between the two rings.
+			if(bucket.count && bucket.timestamp > last && (bucket.timestamp + interval) > from) {
+				append(value,bucket);
+			}
+			return true;
+		});
+
+	}
+
+	Abstract::Agent::History::History(size_t samples, size_t m, size_t h) : raw{samples}, minutes{60,m}, hours{3600,h} {
+	}
+
+	std::shared_ptr<Abstract::Agent::History> Abstract::Agent::History::Factory(const XML::Node &node) {
+
+		size_t samples = XML::AttributeFactory(node,"history").as_uint(Config::Value<unsigned int>("agent-defaults","history",0).get());
+		if(!samples) {
+			return std::shared_ptr<History>();
+		}
+
+		return make_shared<History>(
+			samples,
+			XML::AttributeFactory(node,"history-minutes").as_uint(Config::Value<unsigned int>("agent-defaults","history-minutes",1440).get()),
+			XML::AttributeFactory(node,"history-hours").as_uint(Config::Value<unsigned int>("agent-defaults","history-hours",168).get())
+		);
+
+	}
+
+	void Abstract::Agent::History::add(time_t timestamp, double value) noexcept {
+		lock_guard<mutex> lock(guard);
+		raw.push(Sample{timestamp,value});
+		minutes.add(timestamp,value);
+		hours.add(timestamp,value);
+	}
+
+	bool Abstract::Agent::History::get(const char *path, Value &value) const {
+
+		if(*path == '/') {
+			path++;
+		}
+
+		size_t len;
+		time_t from = 0;
+		const char *next = strchr(path,'/');
+		if(next) {
+			len = next-path;
+			time_t seconds = (time_t) strtoul(next+1,nullptr,10);
+			if(seconds) {
+				from = time(0) - seconds;
+			}
+		} else {
+			len = strlen(path);
+		}
+
+		auto match = [path,len](const char *name) {
+			return strlen(name) == len && !strncasecmp(path,name,len);
+		};
+
+		if(!len || match("raw")) {
+
+			raw.for_each([&](const Sample &sample){
+				if(sample.timestamp >= from) {
+					Value &row = value.append(Value::Object);
+					row["timestamp"] = TimeStamp{sample.timestamp};
+					row["value"] = sample.value;
+				}
+				return false;
+			});
+
+		} else if(match("minutes")) {
+
+			minutes.get(from,value);
+
+		} else if(match("hours")) {
+
+			hours.get(from,value);
+
+		} else {
+
+			return false;
+
+		}
+
+		return true;
+
+	}
+
+	void Abstract::Agent::sample(double value) noexcept {
+		if(history) {
+			history->add(time(0),value);
+		}
+	}
+
+ }
@@ -0,0 +1,232 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements the OpenMetrics exposition of the agent tree.
+  */
+
+ // https://github.com/prometheus/OpenMetrics/blob/main/specification/OpenMetrics.md
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/agent/abstract.h>
+ #include <udjat/agent/level.h>
+ #include <udjat/tools/value.h>
+ #include <unordered_set>
+ #include <ostream>
+ #include <string>
+ #include <cstdio>
+ #include <cctype>
+ #include <cmath>
+ #include <mutex>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	struct Abstract::Agent::Metrics {
+
+		std::ostream &out;
+
+		/// @brief The metric family being written.
+		enum Family : uint8_t {
+			Values,		///< @brief One gauge for each numeric agent.
+			States,		///< @brief The 'udjat_agent_state' stateset.
+			Levels,		///< @brief The 'udjat_agent_level' gauge.
+		} family = Values;
+
+		/// @brief Metric names already used.
+		std::unordered_set<std::string> names;
+
+		Metrics(std::ostream &o) : out{o} {
+			names.insert("udjat_agent_state");
+			names.insert("udjat_agent_level");
+		}
+
+	};
+
+	/// @brief Escape label value or help text.
+	static void escape(std::ostream &out, const char *str) {
+		for(;*str;str++) {
+			switch(*str) {
+			case '\\':
+				out << "\\\\";
+				break;
+
+			case '"':
+				out << "\\\"";
+				break;
+
+			case '\n':
+				out << "\\n";
+				break;
+
+			default:
+				out << *str;
+			}
+		}
+	}
+
+	/// @brief Build metric name from agent path.
+	static std::string MetricName(const std::string &path) {
+		std::string name{"udjat"};
+		name.reserve(path.size()+5);
+		for(char chr : path) {
+			if(!(isalnum((unsigned char) chr) || chr == '_')) {
+				chr = '_';
+			}
+			name += chr;
+		}
+		return name;
+	}
+
+	static void write(std::ostream &out, double value) {
+		if(std::isnan(value)) {
+			out << "NaN";
+		} else if(std::isinf(value)) {
+			out << (value > 0 ? "+Inf" : "-Inf");
+		} else {
+			char buffer[32];
+			snprintf(buffer,sizeof(buffer),"%.17g",value);
+			out << buffer;
+		}
+	}
+
+	void Abstract::Agent::to_openmetrics(std::ostream &out) const {
+
+		Metrics metrics{out};
+
+		lock_guard<std::recursive_mutex> lock(guard);
+
+		std::string path{this->path()};
+
+		// Numeric values, one gauge for each agent.
+		to_openmetrics(metrics,path);
+
+		// Agent states, on a single stateset family.
+		out << "# TYPE udjat_agent_state stateset\n"
+			<< "# HELP udjat_agent_state Agent states, the current one is set.\n";
+
+		metrics.family = Metrics::States;
+		to_openmetrics(metrics,path);
+
+		// Current state levels, on a single gauge family.
+		out << "# TYPE udjat_agent_level gauge\n"
+			<< "# HELP udjat_agent_level Level of the current agent state.\n";
+
+		metrics.family = Metrics::Levels;
+		to_openmetrics(metrics,path);
+
+		out << "# EOF\n";
+
+	}
+
+	void Abstract::Agent::to_openmetrics(Metrics &metrics, const std::string &path) const {
+
+		const char *agent = path.empty() ? "/" : path.c_str();
+
+		if(metrics.family == Metrics::States) {
+
+			// One sample for each state, the label sets must be unique.
+			auto current = this->state();
+			std::unordered_set<std::string> names;
+
+			auto sample = [&](const char *name, bool active) {
+				if(!names.insert(name).second) {
+					return;
+				}
+				metrics.out << "udjat_agent_state{agent=\"";
+				escape(metrics.out,agent);
+				metrics.out << "\",udjat_agent_state=\"";
+				escape(metrics.out,name);
+				metrics.out << "\"} " << (active ? "1" : "0") << "\n";
+			};
+
+			// The current state first, it wins over other states with the same name.
+			sample(current->name(),true);
+			for_each([&](const Abstract::State &state){
+				sample(state.name(),false);
+			});
+
+		} else if(metrics.family == Metrics::Levels) {
+
+			metrics.out << "udjat_agent_level{agent=\"";
+			escape(metrics.out,agent);
+			metrics.out << "\"} " << (int) this->state()->level() << "\n";
+
+		} else {
+
+			Value value;
+			get(value);
+
+			switch((Value::Type) value) {
+			case Value::Signed:
+			case Value::Unsigned:
+			case Value::Real:
+			case Value::Fraction:
+			case Value::Boolean:
+				{
+					double number = 0;
+					value.get(number);
+
+					std::string name{MetricName(path)};
+					if(!metrics.names.insert(name).second) {
+						// Two paths with the same sanitized name, make it unique.
+						std::string base{name};
+						for(size_t suffix = metrics.names.size(); !metrics.names.insert(name).second; suffix++) {
+							name = base + "_" + std::to_string(suffix);
+						}
+					}
+
+					metrics.out << "# TYPE " << name << " gauge\n";
+
+					const char *help = summary();
+					if(!(help && *help)) {
+						help = label();
+					}
+					if(help && *help) {
+						metrics.out << "# HELP " << name << " ";
+						escape(metrics.out,help);
+						metrics.out << "\n";
+					}
+
+					metrics.out << name << "{agent=\"";
+					escape(metrics.out,agent);
+					metrics.out << "\"} ";
+					write(metrics.out,number);
+					metrics.out << "\n";
+
+				}
+				break;
+
+			default:
+				break;
+			}
+
+		}
+
+		// The children list can change while walking, keep it locked.
+		lock_guard<std::recursive_mutex> lock(guard);
+		for(const auto &child : children.agents) {
+			child->to_openmetrics(metrics,path + "/" + child->name());
+		}
+
+	}
+
+ }
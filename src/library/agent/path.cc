@@ -20,6 +20,7 @@
  #include <config.h>
  #include <udjat/defs.h>
  #include <private/agent.h>
+ #include <private/history.h>
  #include <udjat/tools/object.h>
  #include <udjat/agent/abstract.h>
  #include <udjat/tools/logger.h>
@@ -80,6 +81,11 @@
 			return true;
 		}
 
+		if(history && !strncasecmp(path,"history",7) && (!path[7] || path[7] == '/')) {
+			// history[/raw|minutes|hours[/seconds]]
+			return history->get(path+7,value);
+		}
+
 		if(!strcasecmp(path,"states")) {
 
 			for_each([this,&value](const Abstract::State &state) {
@@ -95,6 +95,7 @@
 		if(onStateChange(state,false,"State set to '{}' from parent ({})")) {
 			current_state.activation = current_state.StateWasForwarded;
 			update.next = 0;
+			touch();
 			lock_guard<std::recursive_mutex> lock(guard);
 			for(auto child : children.agents) {
 				child->forward(state);
@@ -0,0 +1,169 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements the agent generation and the serialized response cache.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/agent/abstract.h>
+ #include <udjat/tools/response.h>
+ #include <udjat/tools/logger.h>
+ #include <private/snapshot.h>
+ #include <atomic>
+ #include <sstream>
+ #include <cstdio>
+ #include <ctime>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	uint64_t Abstract::Agent::next_generation() noexcept {
+		// Start from the current time, the entity tags should not repeat after a restart.
+		static atomic<uint64_t> generation{((uint64_t) time(nullptr)) << 24};
+		return ++generation;
+	}
+
+	void Abstract::Agent::touch() noexcept {
+
+		// Every change gets an unique value, two snapshots with the same generation
+		// have the same contents even when agents are updated concurrently.
+		uint64_t value = next_generation();
+
+		for(Agent *agent = this; agent; agent = agent->parent) {
+			agent->changes.store(value,memory_order_release);
+		}
+
+	}
+
+	static string EntityTag(uint64_t generation, const MimeType mimetype) {
+		char buffer[48];
+		snprintf(buffer,sizeof(buffer),"\"%llx-%x\"",(unsigned long long) generation,(unsigned int) mimetype);
+		return buffer;
+	}
+
+	std::string Abstract::Agent::etag(const MimeType mimetype) const {
+		return EntityTag(generation(),mimetype);
+	}
+
+	bool Abstract::Agent::cacheable() const noexcept {
+		return true;
+	}
+
+	std::shared_ptr<Abstract::Agent::Snapshot> Abstract::Agent::Snapshot::getInstance(const Abstract::Agent &agent) {
+
+		auto instance = std::atomic_load(&agent.snapshots);
+		if(instance) {
+			return instance;
+		}
+
+		auto created = make_shared<Snapshot>();
+		if(std::atomic_compare_exchange_strong(&agent.snapshots,&instance,created)) {
+			return created;
+		}
+
+		// Created by another thread.
+		return instance;
+
+	}
+
+	std::shared_ptr<const std::string> Abstract::Agent::Snapshot::get(const MimeType mimetype, uint64_t generation) {
+		lock_guard<mutex> lock(guard);
+		for(const Entry &entry : entries) {
+			if(entry.mimetype == mimetype) {
+				if(entry.generation == generation) {
+					return entry.contents;
+				}
+				break;
+			}
+		}
+		return std::shared_ptr<const std::string>();
+	}
+
+	void Abstract::Agent::Snapshot::set(const MimeType mimetype, uint64_t generation, std::shared_ptr<const std::string> contents) {
+		lock_guard<mutex> lock(guard);
+		for(Entry &entry : entries) {
+			if(entry.mimetype == mimetype) {
+				entry.generation = generation;
+				entry.contents = contents;
+				return;
+			}
+		}
+		entries.push_back(Entry{mimetype,generation,contents});
+	}
+
+	bool Abstract::Agent::snapshot(Udjat::Response &response) const {
+
+		const MimeType mimetype = (MimeType) response;
+
+		// Get the generation before building the response, a change while
+		// serializing will invalidate the snapshot on the next request.
+		uint64_t generation = this->generation();
+
+		response.message(state()->to_string().c_str());
+
+		std::shared_ptr<Snapshot> snapshot;
+		std::shared_ptr<const std::string> contents;
+
+		if(cacheable()) {
+			snapshot = Snapshot::getInstance(*this);
+			contents = snapshot->get(mimetype,generation);
+			if(contents) {
+				if(mimetype != MimeType::openmetrics) {
+					// Keep the response values, not every writer uses the snapshot.
+					getProperties((Value &) response);
+				}
+				response.snapshot(contents);
+				return true;
+			}
+		}
+
+		try {
+
+			stringstream stream;
+
+			if(mimetype == MimeType::openmetrics) {
+				// Stream the agent tree directly, without the response values.
+				to_openmetrics(stream);
+			} else {
+				getProperties((Value &) response);
+				response.serialize(stream);
+			}
+
+			contents = make_shared<const std::string>(stream.str());
+
+		} catch(const std::exception &e) {
+
+			// Not serializable, send the response values.
+			Logger::String{"Cant serialize '",name(),"' to ",std::to_string(mimetype),": ",e.what()}.trace("agent");
+			return false;
+
+		}
+
+		if(snapshot) {
+			snapshot->set(mimetype,generation,contents);
+		}
+		response.snapshot(contents);
+
+		return false;
+	}
+
+ }
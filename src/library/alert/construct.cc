@@ -31,23 +31,87 @@
  #include <udjat/tools/threadpool.h>
  #include <udjat/tools/container.h>
  #include <udjat/tools/timer.h>
+ #include <udjat/tools/configuration.h>
+ #include <unordered_map>
+ #include <unordered_set>
  #include <functional>
+ #include <algorithm>
+ #include <cerrno>
+ #include <chrono>
+ #include <mutex>
+ #include <queue>
+ #include <vector>
 
  namespace Udjat {
 
-	class Alert::Controller : private Udjat::Container<Alert> {
+	/// @brief Alert scheduler.
+	/// @details Due alerts are kept on a min-heap by activation time; entries are validated when popped,
+	/// so rescheduling an alert just pushes a new entry. Emissions are limited by a global and a
+	/// per-destination concurrency limit, and by a token bucket for each destination.
+	class Alert::Controller {
 	private:
 
+		std::mutex guard;
+
 		Timer *timer;
 
+		/// @brief Registered alerts.
+		std::unordered_set<Alert *> alerts;
+
+		/// @brief Heap entry.
+		struct Due {
+			time_t when;
+			Alert *alert;
+
+			inline bool operator>(const Due &other) const noexcept {
+				return when > other.when;
+			}
+		};
+
+		std::priority_queue<Due,std::vector<Due>,std::greater<Due>> queue;
+
+		/// @brief Limits for a destination.
+		struct Destination {
+			size_t running = 0;				///< @brief Running emissions.
+			double tokens = 0;				///< @brief Available tokens.
+			std::chrono::steady_clock::time_point updated;
+		};
+
+		std::unordered_map<std::string,Destination> destinations;
+
+		/// @brief Running emissions.
+		size_t running = 0;
+
+		struct {
+			size_t running;			///< @brief Maximum number of concurrent emissions.
+			size_t destination;		///< @brief Maximum number of concurrent emissions for each destination.
+			double rate;			///< @brief Emissions per second for each destination.
+			double burst;			///< @brief Token bucket size.
+			size_t batch;			///< @brief Maximum number of alerts in a batch.
+		} limits;
+
 		static bool on_timer() noexcept {
 			ThreadPool::getInstance().push([](){
-				getInstance().wakeup();
+				getInstance().dispatch();
 			});
 			return true;
 		}
 
 		Controller() : timer{Timer::Factory(60000,[](){return on_timer();})} {
+			limits.running = Config::Value<unsigned int>("alerts","max-running",32).get();
+			limits.destination = Config::Value<unsigned int>("alerts","max-per-destination",4).get();
+			limits.rate = Config::Value<double>("alerts","rate",10.0).get();
+			limits.burst = Config::Value<double>("alerts","burst",20.0).get();
+			limits.batch = Config::Value<unsigned int>("alerts","max-batch",32).get();
+			if(!limits.running) {
+				limits.running = 1;
+			}
+			if(!limits.batch) {
+				limits.batch = 1;
+			}
+			if(!limits.destination) {
+				limits.destination = 1;
+			}
 			Logger::String{"Alert controller initialized"}.info();
 		}
 
@@ -56,6 +120,101 @@
 			Logger::String{"Alert controller finalized"}.info();
 		}
 
+		/// @brief Push alert to the queue, rebuilding it when there's too many stale entries.
+		void push(Alert *alert, time_t when) {
+
+			if(queue.size() > (alerts.size() * 2) + 64) {
+				std::priority_queue<Due,std::vector<Due>,std::greater<Due>> active;
+				for(Alert *item : alerts) {
+					if(item->activation.next) {
+						active.push(Due{item->activation.next,item});
+					}
+				}
+				queue.swap(active);
+			}
+
+			queue.push(Due{when,alert});
+
+		}
+
+		/// @brief Take a token from the destination bucket.
+		/// @return 0 if a token was available, seconds to wait if not.
+		time_t consume(Destination &destination) {
+
+			if(limits.rate <= 0) {
+				return 0;
+			}
+
+			auto now = std::chrono::steady_clock::now();
+			if(destination.updated.time_since_epoch().count() == 0) {
+				destination.tokens = limits.burst;
+			} else {
+				double elapsed = std::chrono::duration<double>(now - destination.updated).count();
+				destination.tokens = std::min(limits.burst, destination.tokens + (elapsed * limits.rate));
+			}
+			destination.updated = now;
+
+			if(destination.tokens >= 1) {
+				destination.tokens -= 1;
+				return 0;
+			}
+
+			return (time_t) ((1 - destination.tokens) / limits.rate) + 1;
+
+		}
+
+		/// @brief Emit batch of alerts.
+		static void emit(const std::vector<Alert *> &batch) noexcept {
+
+			int result = -ENOTSUP;
+			std::string message;
+
+			if(batch.size() > 1) {
+				try {
+					result = batch.front()->emit(batch);
+				} catch(const std::exception &e) {
+					result = -1;
+					message = e.what();
+				} catch(...) {
+					result = -1;
+					message = "Unexpected error";
+				}
+			}
+
+			if(result == -ENOTSUP) {
+
+				// One by one.
+				for(Alert *alert : batch) {
+					try {
+						int rc = alert->emit();
+						if(rc) {
+							alert->failed(String{"Alert emission failed with rc=",rc}.c_str());
+						} else {
+							alert->success();
+						}
+					} catch(const std::exception &e) {
+						alert->failed(e.what());
+					} catch(...) {
+						alert->failed("Unexpected error");
+					}
+				}
+
+			} else {
+
+				for(Alert *alert : batch) {
+					if(!message.empty()) {
+						alert->failed(message.c_str());
+					} else if(result) {
+						alert->failed(String{"Alert emission failed with rc=",result}.c_str());
+					} else {
+						alert->success();
+					}
+				}
+
+			}
+
+		}
+
 	public:
 		static Controller & getInstance() {
 			static Controller instance;
@@ -63,60 +222,163 @@
 		}
 
 		inline void add(Alert * alert) noexcept {
-			Container<Alert>::add(alert);
-			wakeup();
+			{
+				std::lock_guard<std::mutex> lock(guard);
+				alerts.insert(alert);
+			}
+			schedule(alert);
 		}
 
 		inline void remove(Alert * alert) noexcept {
-			Container<Alert>::remove(alert);
-			wakeup();
+			std::lock_guard<std::mutex> lock(guard);
+			alerts.erase(alert);
+			// The queue entries are dropped when popped.
 		}
 
-		/// @brief Check for active alerts, emit if necessary, reset timer for next alert.
-		void wakeup() {
+		/// @brief Queue alert for its next activation.
+		void schedule(Alert *alert) noexcept {
 
-			std::lock_guard<std::mutex> lock(guard);
-			debug("Waking up alert controller");
+			bool now = false;
 
-			time_t now = time(0);
-			time_t next = now + 600;
+			{
+				std::lock_guard<std::mutex> lock(guard);
 
-			for(Alert *alert : *this) {
+				time_t next = alert->activation.next;
+				if(!next || !alerts.count(alert)) {
+					return;
+				}
+
+				push(alert,next);
 
-				if(!alert->activation.next) {
-					continue;
+				if(queue.top().alert == alert && queue.top().when == next) {
+					// It's the first one, reset timer.
+					time_t delay = next - time(0);
+					if(delay <= 0) {
+						now = true;
+					} else {
+						timer->set(delay * 1000);
+					}
 				}
 
-				if(alert->activation.next <= now) {	
+			}
+
+			if(now) {
+				dispatch();
+			}
+
+		}
+
+		/// @brief Emit the due alerts, reset timer for next alert.
+		void dispatch() {
+
+			std::vector<std::pair<std::string,std::vector<Alert *>>> batches;
+
+			{
+				std::lock_guard<std::mutex> lock(guard);
+				debug("Waking up alert controller");
+
+				time_t now = time(0);
+
+				std::vector<Due> deferred;
+				std::unordered_map<std::string,size_t> index;	// Batch by destination.
 
-					// Emit alert.
+				while(!queue.empty() && queue.top().when <= now) {
+
+					Due due = queue.top();
+					queue.pop();
+
+					Alert *alert = due.alert;
+					if(!alerts.count(alert) || !alert->activation.next || alert->activation.next > now) {
+						continue;	// Removed, deactivated or rescheduled.
+					}
+
+					if(alert->activation.running) {
+						deferred.push_back(Due{now+1,alert});
+						continue;
+					}
+
+					std::string name{alert->destination()};
+
+					auto batch = index.find(name);
+					if(!name.empty() && batch != index.end() && batches[batch->second].second.size() < limits.batch) {
+						// Join the batch.
+						batches[batch->second].second.push_back(alert);
+						alert->activation.running = true;
+						alert->activation.next = 0;
+						continue;
+					}
+
+					// New task, check limits.
+					if(running >= limits.running) {
+						deferred.push_back(Due{now+1,alert});
+						continue;
+					}
+
+					if(!name.empty()) {
+
+						Destination &destination = destinations[name];
+
+						if(destination.running >= limits.destination) {
+							deferred.push_back(Due{now+1,alert});
+							continue;
+						}
+
+						time_t wait = consume(destination);
+						if(wait) {
+							deferred.push_back(Due{now+wait,alert});
+							continue;
+						}
+
+						destination.running++;
+						index[name] = batches.size();
+
+					}
+
+					running++;
 					alert->activation.running = true;
 					alert->activation.next = 0;
-					ThreadPool::getInstance().push([alert](){
-						try {
-							int result = alert->emit();
-							if(result) {
-								alert->failed(String{"Alert emission failed with rc=",result}.c_str());
-							} else {
-								alert->success();
-							}
-						} catch(const std::exception &e) {
-							alert->failed(e.what());
-						} catch(...) {
-							alert->failed("Unexpected error");
-						}
-						alert->activation.running = false;
-						getInstance().wakeup();
-					});
+					batches.emplace_back(name,std::vector<Alert *>{alert});
+
+				}
 
-				} else {
-					next = std::min(next,alert->activation.next);
+				for(const Due &due : deferred) {
+					push(due.alert,due.when);
 				}
 
+				// Reset timer for the next alert.
+				time_t next = queue.empty() ? now + 600 : std::max(queue.top().when,now+1);
+				debug("Next alert in ",next - now," seconds at ",TimeStamp(next).to_string().c_str());
+				timer->set((next - now) * 1000);
+
 			}
 
-			debug("Next alert in ",next - now," seconds at ",TimeStamp(next).to_string().c_str());
-			timer->set((next - now) * 1000);
+			for(auto &batch : batches) {
+
+				auto alerts = std::make_shared<std::pair<std::string,std::vector<Alert *>>>(std::move(batch));
+
+				ThreadPool::getInstance().push([alerts](){
+
+					emit(alerts->second);
+
+					Controller &controller = getInstance();
+					{
+						std::lock_guard<std::mutex> lock(controller.guard);
+						for(Alert *alert : alerts->second) {
+							if(controller.alerts.count(alert)) {
+								alert->activation.running = false;
+							}
+						}
+						controller.running--;
+						if(!alerts->first.empty()) {
+							controller.destinations[alerts->first].running--;
+						}
+					}
+
+					controller.dispatch();
+
+				});
+
+			}
 
 		}
 
@@ -156,6 +418,14 @@
 
 	}
 
+	int Alert::emit(const std::vector<Alert *> &) {
+		return -ENOTSUP;
+	}
+
+	std::string Alert::destination() const {
+		return std::string{};
+	}
+
 	void Alert::reset(time_t next) noexcept {
 		activation.suceeded = 0;
 		activation.failed = 0;
@@ -176,7 +446,7 @@
 			"Alert activation scheduled to ",
 			TimeStamp(activation.next).to_string().c_str()
 		}.info(name());
-		Controller::getInstance().wakeup();
+		Controller::getInstance().schedule(this);
 		return true;
 	}
 
@@ -194,7 +464,7 @@
 				TimeStamp(activation.next).to_string().c_str()
 			}.info(name());
 		}
-		Controller::getInstance().wakeup();
+		Controller::getInstance().schedule(this);
 	}
 
 	bool Alert::deactivate() noexcept {
@@ -210,7 +480,7 @@
 		}
 
 		reset(0);
-		Controller::getInstance().wakeup();
+		Controller::getInstance().schedule(this);
 
 		return true;
 	}
@@ -250,7 +520,7 @@
 
 		}
 
-		Controller::getInstance().wakeup();
+		Controller::getInstance().schedule(this);
 
 	}
 
@@ -289,7 +559,7 @@
 
 		}
 
-		Controller::getInstance().wakeup();
+		Controller::getInstance().schedule(this);
 
 	}
 
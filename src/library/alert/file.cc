@@ -24,9 +24,17 @@
  #include <udjat/tools/logger.h>
  #include <sys/stat.h>
  #include <fstream>
+ #include <cstring>
+ #include <cerrno>
  #include <udjat/tools/string.h>
  #include <udjat/tools/xml.h>
  #include <udjat/tools/timestamp.h>
+ #include <udjat/tools/configuration.h>
+
+ #ifndef _WIN32
+	#include <private/linux/spool.h>
+	#include <private/linux/filesink.h>
+ #endif // _WIN32
 
  using namespace std;
 
@@ -34,7 +42,11 @@
 
 	FileAlert::FileAlert(const XML::Node &node) : Alert{node},
 
-		filename{String{node,"filename"}.as_quark()}, maxage{node.attribute("maxage").as_uint(86400)}, 
+		filename{String{node,"filename"}.as_quark()}, maxage{node.attribute("maxage").as_uint(86400)},
+
+		maxsize{(size_t) node.attribute("maxsize").as_ullong(0)},
+
+		spool{node.attribute("spool").as_bool(Config::Value<bool>("alerts","spool",false).get())},
 	
 		payload{Activatable::payload(node)} {
 
@@ -74,7 +86,7 @@
 		return super::activate();
 	}
 
-	int FileAlert::emit() {
+	String FileAlert::path() const {
 
 		String name{filename};
 		name.expand();
@@ -83,6 +95,19 @@
 			name = TimeStamp().to_string(name.c_str());
 		}
 
+		return name;
+	}
+
+	std::string FileAlert::destination() const {
+		return filename;
+	}
+
+	void FileAlert::write(const std::vector<std::string> &payloads) {
+
+		String name{path()};
+
+#ifdef _WIN32
+
 		if(maxage) {
 			struct stat st;
 			if(!stat(name.c_str(),&st) && (time(nullptr) - st.st_mtime) > maxage) {
@@ -95,13 +120,51 @@
 		std::ofstream ofs;
 		ofs.exceptions(std::ofstream::failbit | std::ofstream::badbit);
 
-		debug("Writing alert to file '",name.c_str(),"'");
+		debug("Writing ",payloads.size()," alert(s) to file '",name.c_str(),"'");
 		ofs.open(name, ofstream::out | ofstream::app);
-		ofs << payload.value << endl;
+		for(const std::string &payload : payloads) {
+			ofs << payload << endl;
+		}
 		ofs.close();
 
+#else
+
+		if(spool) {
+			// Rendered once, the spool keeps it until written.
+			for(const std::string &payload : payloads) {
+				Spool::getInstance().push(name.c_str(),Spool::Append,payload.c_str(),maxage,maxsize);
+			}
+			return;
+		}
+
+		debug("Writing ",payloads.size()," alert(s) to file '",name.c_str(),"'");
+		File::Sink::getInstance(name.c_str())->write(payloads,maxage,maxsize);
+
+#endif // _WIN32
+
+	}
+
+	int FileAlert::emit() {
+		write(std::vector<std::string>{payload.value});
+		return 0;
+	}
+
+	int FileAlert::emit(const std::vector<Alert *> &alerts) {
+
+		std::vector<std::string> payloads;
+		payloads.reserve(alerts.size());
+
+		for(Alert *alert : alerts) {
+			const FileAlert *falert = dynamic_cast<const FileAlert *>(alert);
+			if(!falert || strcmp(falert->filename,filename)) {
+				return -ENOTSUP;
+			}
+			payloads.push_back(falert->payload.value);
+		}
+
+		write(payloads);
 		return 0;
 
 	}
 
- }
\ No newline at end of file
+ }
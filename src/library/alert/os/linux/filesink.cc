@@ -0,0 +1,313 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements the shared file writers.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <private/linux/filesink.h>
+ #include <udjat/tools/configuration.h>
+ #include <udjat/tools/threadpool.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/timer.h>
+ #include <sys/types.h>
+ #include <sys/stat.h>
+ #include <sys/uio.h>
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <unordered_map>
+ #include <system_error>
+ #include <algorithm>
+ #include <climits>
+ #include <cstring>
+ #include <cerrno>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	static mutex pool;
+
+	/// @brief Open sinks, by expanded filename.
+	static unordered_map<string,shared_ptr<File::Sink>> & Sinks() {
+		static unordered_map<string,shared_ptr<File::Sink>> instance;
+		return instance;
+	}
+
+	/// @brief Seconds between the maintenance runs (and fdatasync() calls).
+	static time_t SyncInterval() {
+		static time_t interval = std::max(1U,Config::Value<unsigned int>("alerts","file-sync-interval",5).get());
+		return interval;
+	}
+
+	File::Sink::Sink(const char *f) : filename{f} {
+	}
+
+	File::Sink::~Sink() {
+		lock_guard<mutex> lock(io);
+		close();
+	}
+
+	shared_ptr<File::Sink> File::Sink::getInstance(const char *filename) {
+
+		static Timer *timer = nullptr;
+
+		lock_guard<mutex> lock(pool);
+
+		auto &sinks = Sinks();
+		auto it = sinks.find(filename);
+		if(it != sinks.end()) {
+			return it->second;
+		}
+
+		if(!timer) {
+			timer = Timer::Factory(SyncInterval() * 1000,[](){
+				ThreadPool::getInstance().push("file-sinks",[](){
+					maintenance();
+				});
+				return true;
+			});
+		}
+
+		auto sink = make_shared<Sink>(filename);
+		sinks[filename] = sink;
+		return sink;
+
+	}
+
+	void File::Sink::maintenance() noexcept {
+
+		static time_t idle = Config::Value<unsigned int>("alerts","file-idle-timeout",60).get();
+
+		vector<shared_ptr<Sink>> sinks;
+		{
+			lock_guard<mutex> lock(pool);
+			for(auto &it : Sinks()) {
+				sinks.push_back(it.second);
+			}
+		}
+
+		time_t now = time(0);
+		for(auto &sink : sinks) {
+
+			if(!sink->maintain(now,SyncInterval(),idle)) {
+				continue;
+			}
+
+			// Idle, release it if nobody else has a reference.
+			lock_guard<mutex> lock(pool);
+			auto it = Sinks().find(sink->filename);
+			if(it != Sinks().end() && it->second.use_count() == 2) {
+				Sinks().erase(it);
+			}
+
+		}
+
+	}
+
+	void File::Sink::open() {
+
+		if(fd >= 0) {
+			return;
+		}
+
+		fd = ::open(filename.c_str(),O_WRONLY|O_APPEND|O_CREAT|O_CLOEXEC,0644);
+		if(fd < 0) {
+			throw system_error(errno,system_category(),filename);
+		}
+
+		struct stat st;
+		if(!fstat(fd,&st) && st.st_size) {
+			updated = st.st_mtime;
+		} else {
+			updated = 0;
+		}
+
+	}
+
+	void File::Sink::close() noexcept {
+		if(fd >= 0) {
+			if(dirty) {
+				fdatasync(fd);
+				dirty = false;
+			}
+			::close(fd);
+			fd = -1;
+		}
+	}
+
+	void File::Sink::write(const std::vector<std::string> &lines, time_t maxage, size_t size) {
+
+		uint64_t ticket;
+
+		{
+			lock_guard<mutex> lock(guard);
+			pending.insert(pending.end(),lines.begin(),lines.end());
+			ticket = ++queued;
+			used = time(0);
+			if(size) {
+				maxsize = size;
+			}
+		}
+
+		lock_guard<mutex> lock(io);
+
+		unique_lock<mutex> state(guard);
+		if(written < ticket) {
+			// Not written yet, write it with everything else pending.
+			state.unlock();
+			flush(maxage);
+			state.lock();
+		}
+
+		auto failed = failures.find(ticket);
+		if(failed != failures.end()) {
+			int error = failed->second;
+			failures.erase(failed);
+			throw system_error(error,system_category(),filename);
+		}
+
+	}
+
+	void File::Sink::flush(time_t maxage) noexcept {
+
+		vector<string> lines;
+		uint64_t last;
+
+		{
+			lock_guard<mutex> lock(guard);
+			lines.swap(pending);
+			last = queued;
+		}
+
+		int error = 0;
+		time_t now = time(0);
+
+		try {
+
+			if(maxage && updated && (now - updated) > maxage) {
+				// Its an old file, remove it
+				Logger::String{"Removing ",filename.c_str()}.info("alerts");
+				close();
+				unlink(filename.c_str());
+			}
+
+			open();
+
+			static char newline = '\n';
+			vector<struct iovec> iov;
+			iov.reserve(lines.size() * 2);
+			for(string &line : lines) {
+				iov.push_back(iovec{(void *) line.data(),line.size()});
+				iov.push_back(iovec{&newline,1});
+			}
+
+			// The descriptor is in append mode, resume the partial writes from where they stopped.
+			size_t index = 0;
+			while(index < iov.size()) {
+
+				ssize_t bytes = writev(fd,iov.data()+index,std::min(iov.size()-index,(size_t) IOV_MAX));
+				if(bytes < 0) {
+					if(errno == EINTR) {
+						continue;
+					}
+					throw system_error(errno,system_category(),filename);
+				}
+
+				while(index < iov.size() && (size_t) bytes >= iov[index].iov_len) {
+					bytes -= iov[index].iov_len;
+					index++;
+				}
+
+				if(index < iov.size()) {
+					iov[index].iov_base = ((uint8_t *) iov[index].iov_base) + bytes;
+					iov[index].iov_len -= bytes;
+				}
+
+			}
+
+			updated = now;
+			dirty = true;
+
+		} catch(const system_error &e) {
+			error = e.code().value();
+			Logger::String{e.what()}.error("alerts");
+		} catch(const std::exception &e) {
+			error = EIO;
+			Logger::String{e.what()}.error("alerts");
+		}
+
+		lock_guard<mutex> lock(guard);
+		if(error) {
+			for(uint64_t ticket = written+1; ticket <= last; ticket++) {
+				failures[ticket] = error;
+			}
+		}
+		written = last;
+
+	}
+
+	bool File::Sink::maintain(time_t now, time_t interval, time_t idle) noexcept {
+
+		lock_guard<mutex> lock(io);
+
+		if(fd < 0) {
+			lock_guard<mutex> lock(guard);
+			return pending.empty() && (now - used) > idle;
+		}
+
+		if(dirty && (now - synced) >= interval) {
+			fdatasync(fd);
+			dirty = false;
+			synced = now;
+		}
+
+		struct stat current, opened;
+		if(stat(filename.c_str(),&current) || fstat(fd,&opened) || current.st_ino != opened.st_ino || current.st_dev != opened.st_dev) {
+
+			// Renamed or removed by someone else, reopen on next write.
+			close();
+
+		} else if(maxsize && (size_t) opened.st_size >= maxsize) {
+
+			string rotated{filename + ".old"};
+			Logger::String{"Rotating ",filename.c_str()," to ",rotated.c_str()}.info("alerts");
+			close();
+			if(rename(filename.c_str(),rotated.c_str())) {
+				Logger::String{filename.c_str(),": ",strerror(errno)}.error("alerts");
+			}
+
+		} else if((now - used) > idle) {
+
+			close();
+
+		}
+
+		if(fd >= 0) {
+			return false;
+		}
+
+		lock_guard<mutex> lck(guard);
+		return pending.empty() && (now - used) > idle;
+
+	}
+
+ }
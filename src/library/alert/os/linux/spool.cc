@@ -0,0 +1,559 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements the persistent alert spool.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <private/linux/spool.h>
+ #include <private/linux/filesink.h>
+ #include <udjat/tools/application.h>
+ #include <udjat/tools/configuration.h>
+ #include <udjat/tools/threadpool.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/string.h>
+ #include <udjat/tools/url.h>
+ #include <sys/types.h>
+ #include <sys/stat.h>
+ #include <sys/mman.h>
+ #include <dirent.h>
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <algorithm>
+ #include <stdexcept>
+ #include <system_error>
+ #include <cstring>
+ #include <cstddef>
+ #include <climits>
+ #include <cerrno>
+ #include <vector>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	static const char segment_magic[8] = { 'U', 'D', 'J', 'S', 'P', 'O', 'O', 'L' };
+	static constexpr uint32_t record_magic = 0x52415055;
+	static constexpr uint32_t segment_version = 2;
+
+	/// @brief Length of the version 1 record headers, without the file options.
+	static constexpr size_t record_v1 = 16;
+
+	static inline size_t align(size_t length) noexcept {
+		return (length + 7) & ~((size_t) 7);
+	}
+
+	Alert::Spool & Alert::Spool::getInstance() {
+		static Spool instance;
+		return instance;
+	}
+
+	Alert::Spool::Spool() : timer{Timer::Factory(60000,[](){
+		getInstance().start();
+		return true;
+	})} {
+
+		limits.segment = align(Config::Value<unsigned int>("alerts","spool-segment-size",1048576).get());
+		limits.batch = Config::Value<unsigned int>("alerts","spool-batch",64).get();
+		limits.retry = Config::Value<unsigned int>("alerts","spool-retry",5).get();
+		limits.maxretry = Config::Value<unsigned int>("alerts","spool-max-retry",600).get();
+		limits.sync = Config::Value<bool>("alerts","spool-sync",false).get();
+
+		if(limits.segment < 4096) {
+			limits.segment = 4096;
+		}
+		if(!limits.batch) {
+			limits.batch = 1;
+		}
+		if(!limits.retry) {
+			limits.retry = 1;
+		}
+		if(limits.maxretry < limits.retry) {
+			limits.maxretry = limits.retry;
+		}
+
+		path = Application::CacheDir{"alerts"};
+
+		// Load segments from previous runs, in creation order.
+		vector<string> files;
+		DIR *dir = opendir(path.c_str());
+		if(dir) {
+			struct dirent *entry;
+			while((entry = readdir(dir)) != nullptr) {
+				size_t length = strlen(entry->d_name);
+				if(length > 6 && !strcmp(entry->d_name + length - 6,".spool")) {
+					files.emplace_back(entry->d_name);
+				}
+			}
+			closedir(dir);
+		}
+
+		std::sort(files.begin(),files.end());
+		size_t pending = 0;
+		for(const string &file : files) {
+			sequence = std::max(sequence,(uint64_t) strtoull(file.c_str(),nullptr,16));
+			try {
+				load((path + file).c_str());
+				if(!segments.empty()) {
+					pending += segments.back().pending;
+				}
+			} catch(const std::exception &e) {
+				Logger::String{file.c_str(),": ",e.what()}.error("alerts");
+			}
+		}
+
+		if(pending) {
+			Logger::String{"Loaded ",pending," undelivered alert(s) from ",path.c_str()}.info("alerts");
+			timer->set(1000);
+		} else {
+			timer->disable();
+		}
+
+	}
+
+	Alert::Spool::~Spool() {
+		delete timer;
+		lock_guard<mutex> lock(guard);
+		for(Segment &segment : segments) {
+			msync(segment.data,segment.size,MS_SYNC);
+			munmap(segment.data,segment.size);
+		}
+		segments.clear();
+	}
+
+	void Alert::Spool::load(const char *filename) {
+
+		int fd = open(filename,O_RDWR|O_CLOEXEC);
+		if(fd < 0) {
+			throw system_error(errno,system_category(),"Cant open spool segment");
+		}
+
+		struct stat st;
+		if(fstat(fd,&st) || (size_t) st.st_size < sizeof(Header)) {
+			::close(fd);
+			unlink(filename);
+			return;
+		}
+
+		void *data = mmap(NULL,st.st_size,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+		int err = errno;
+		::close(fd);
+
+		if(data == MAP_FAILED) {
+			throw system_error(err,system_category(),"Cant map spool segment");
+		}
+
+		Segment segment;
+		segment.filename = filename;
+		segment.data = (uint8_t *) data;
+		segment.size = st.st_size;
+
+		const Header *header = (const Header *) segment.data;
+		if(memcmp(header->magic,segment_magic,sizeof(segment_magic)) || !header->version || header->version > segment_version) {
+			munmap(segment.data,segment.size);
+			throw runtime_error("Invalid spool segment");
+		}
+
+		static_assert(offsetof(Record,maxsize) == record_v1,"Unexpected version 1 record length");
+		if(header->version == 1) {
+			segment.header = record_v1;
+		}
+
+		// Scan records, a record without magic ends the segment (incomplete write).
+		size_t offset = align(sizeof(Header));
+		segment.cursor = 0;
+		while(offset + segment.header <= segment.size) {
+			const Record *record = (const Record *) (segment.data + offset);
+			if(record->magic != record_magic) {
+				break;
+			}
+			size_t length = align(segment.header + record->destination + record->payload);
+			if(offset + length > segment.size) {
+				break;
+			}
+			if(!record->state) {
+				if(!segment.pending) {
+					segment.cursor = offset;
+				}
+				segment.pending++;
+			}
+			offset += length;
+		}
+
+		// Segments from previous runs are read only.
+		segment.used = segment.size;
+
+		if(!segment.pending) {
+			munmap(segment.data,segment.size);
+			unlink(filename);
+			return;
+		}
+
+		segments.push_back(segment);
+
+	}
+
+	Alert::Spool::Segment & Alert::Spool::create(size_t length) {
+
+		size_t size = std::max(limits.segment,align(sizeof(Header)) + length);
+
+		char name[32];
+		snprintf(name,sizeof(name),"%016llx.spool",(unsigned long long) ++sequence);
+		string filename{path + name};
+
+		int fd = open(filename.c_str(),O_RDWR|O_CREAT|O_EXCL|O_CLOEXEC,0600);
+		if(fd < 0) {
+			throw system_error(errno,system_category(),"Cant create spool segment");
+		}
+
+		if(ftruncate(fd,size)) {
+			int err = errno;
+			::close(fd);
+			unlink(filename.c_str());
+			throw system_error(err,system_category(),"Cant allocate spool segment");
+		}
+
+		void *data = mmap(NULL,size,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+		int err = errno;
+		::close(fd);
+
+		if(data == MAP_FAILED) {
+			unlink(filename.c_str());
+			throw system_error(err,system_category(),"Cant map spool segment");
+		}
+
+		Segment segment;
+		segment.filename = filename;
+		segment.data = (uint8_t *) data;
+		segment.size = size;
+		segment.used = segment.cursor = align(sizeof(Header));
+
+		Header *header = (Header *) segment.data;
+		memcpy(header->magic,segment_magic,sizeof(segment_magic));
+		header->version = segment_version;
+
+		segments.push_back(segment);
+
+		// The previous segment is now read only, release it if already delivered.
+		release();
+
+		return segments.back();
+
+	}
+
+	void Alert::Spool::release() noexcept {
+
+		if(segments.empty()) {
+			return;
+		}
+
+		auto last = std::prev(segments.end());
+		for(auto segment = segments.begin(); segment != last;) {
+			if(segment->pending) {
+				segment++;
+				continue;
+			}
+			munmap(segment->data,segment->size);
+			unlink(segment->filename.c_str());
+			segment = segments.erase(segment);
+		}
+
+	}
+
+	void Alert::Spool::advance(Segment &segment) noexcept {
+
+		while(segment.cursor + segment.header <= segment.used) {
+			const Record *record = (const Record *) (segment.data + segment.cursor);
+			if(__atomic_load_n(&record->magic,__ATOMIC_ACQUIRE) != record_magic || !record->state) {
+				break;
+			}
+			segment.cursor += align(segment.header + record->destination + record->payload);
+		}
+
+	}
+
+	void Alert::Spool::push(const char *destination, uint8_t method, const char *payload, time_t maxage, size_t maxsize) {
+
+		size_t dlen = strlen(destination);
+		size_t plen = strlen(payload);
+		size_t length = align(sizeof(Record) + dlen + plen);
+
+		{
+			lock_guard<mutex> lock(guard);
+
+			Segment *segment = segments.empty() ? nullptr : &segments.back();
+			if(!segment || segment->used + length > segment->size) {
+				segment = &create(length);
+			}
+
+			uint8_t *ptr = segment->data + segment->used;
+			Record *record = (Record *) ptr;
+
+			record->state = 0;
+			record->method = method;
+			record->destination = dlen;
+			record->payload = plen;
+			record->maxsize = maxsize;
+			record->maxage = (uint32_t) std::min(maxage,(time_t) UINT32_MAX);
+			record->options = 0;
+			memcpy(ptr+sizeof(Record),destination,dlen);
+			memcpy(ptr+sizeof(Record)+dlen,payload,plen);
+
+			// Publish the record.
+			__atomic_store_n(&record->magic,record_magic,__ATOMIC_RELEASE);
+
+			if(limits.sync) {
+				uintptr_t page = ((uintptr_t) ptr) & ~((uintptr_t) sysconf(_SC_PAGESIZE) - 1);
+				msync((void *) page,(((uintptr_t) ptr) + length) - page,MS_SYNC);
+			}
+
+			segment->used += length;
+			segment->pending++;
+		}
+
+		start();
+
+	}
+
+	void Alert::Spool::start() noexcept {
+
+		{
+			lock_guard<mutex> lock(guard);
+			if(draining) {
+				return;
+			}
+			draining = true;
+		}
+
+		ThreadPool::getInstance().push("alert-spool",[](){
+
+			Spool &spool = getInstance();
+
+			time_t wait = 0;
+			try {
+				wait = spool.drain();
+			} catch(const std::exception &e) {
+				Logger::String{e.what()}.error("alerts");
+				wait = spool.limits.retry;
+			}
+
+			lock_guard<mutex> lock(spool.guard);
+			spool.draining = false;
+			if(wait) {
+				spool.timer->set(wait * 1000);
+			} else {
+				spool.timer->disable();
+			}
+
+		});
+
+	}
+
+	time_t Alert::Spool::drain() {
+
+		struct Entry {
+			Segment *segment;
+			Record *record;
+		};
+
+		/// @brief Pending records for a destination, in order.
+		struct Queue {
+			uint8_t method;
+			string destination;
+			time_t maxage = 0;		///< @brief File options from the last record.
+			size_t maxsize = 0;
+			vector<Entry> entries;
+		};
+
+		bool more = true;
+		time_t wait = 0;
+
+		while(more) {
+
+			more = false;
+			wait = 0;
+
+			vector<Queue> queues;
+			time_t now = time(0);
+
+			// Collect the pending records, in order, for the destinations not in backoff.
+			{
+				lock_guard<mutex> lock(guard);
+
+				unordered_map<string,size_t> index;
+				unordered_map<string,bool> blocked;
+
+				for(Segment &segment : segments) {
+
+					if(!segment.pending) {
+						continue;
+					}
+
+					// The records before the cursor were already delivered.
+					size_t offset = segment.cursor;
+					while(offset + segment.header <= segment.used) {
+
+						Record *record = (Record *) (segment.data + offset);
+						if(__atomic_load_n(&record->magic,__ATOMIC_ACQUIRE) != record_magic) {
+							break;
+						}
+
+						offset += align(segment.header + record->destination + record->payload);
+
+						if(record->state) {
+							continue;
+						}
+
+						const char *ptr = ((const char *) record) + segment.header;
+						string destination{ptr,record->destination};
+
+						if(blocked.count(destination)) {
+							continue;
+						}
+
+						auto bk = backoff.find(destination);
+						if(bk != backoff.end() && bk->second.next > now) {
+							time_t delay = bk->second.next - now;
+							wait = wait ? std::min(wait,delay) : delay;
+							blocked[destination] = true;
+							continue;
+						}
+
+						auto it = index.find(destination);
+						if(it == index.end()) {
+							it = index.emplace(destination,queues.size()).first;
+							queues.emplace_back();
+							queues.back().method = record->method;
+							queues.back().destination = destination;
+						}
+
+						Queue &queue = queues[it->second];
+						if(queue.method != record->method) {
+							// Keep the order, the remaining records go on the next pass.
+							blocked[destination] = true;
+							more = true;
+							continue;
+						}
+
+						queue.entries.push_back(Entry{&segment,record});
+
+						if(segment.header == sizeof(Record)) {
+							queue.maxage = record->maxage;
+							queue.maxsize = record->maxsize;
+						}
+
+					}
+
+				}
+
+			}
+
+			// Deliver, 'spool-batch' records at a time; the records are not changed after
+			// publication and their segments are kept while they're pending.
+			for(Queue &queue : queues) {
+
+				for(size_t first = 0; first < queue.entries.size(); first += limits.batch) {
+
+					size_t count = std::min(limits.batch,queue.entries.size() - first);
+					size_t sent = 0;
+					string message;
+
+					try {
+
+						vector<string> payloads;
+						payloads.reserve(count);
+						for(size_t ix = first; ix < first+count; ix++) {
+							const Entry &entry = queue.entries[ix];
+							payloads.emplace_back(((const char *) entry.record) + entry.segment->header + entry.record->destination,entry.record->payload);
+						}
+
+						if(queue.method == Append) {
+
+							File::Sink::getInstance(queue.destination.c_str())->write(payloads,queue.maxage,queue.maxsize);
+							sent = payloads.size();
+
+						} else {
+
+							URL url{queue.destination.c_str()};
+							for(const string &payload : payloads) {
+								url.call((HTTP::Method) queue.method,payload.c_str());
+								sent++;
+							}
+
+						}
+
+					} catch(const std::exception &e) {
+						message = e.what();
+					}
+
+					lock_guard<mutex> lock(guard);
+
+					for(size_t ix = first; ix < first+sent; ix++) {
+						Entry &entry = queue.entries[ix];
+						entry.record->state = 1;
+						entry.segment->pending--;
+						advance(*entry.segment);
+					}
+
+					if(message.empty()) {
+
+						backoff.erase(queue.destination);
+
+					} else {
+
+						Backoff &bk = backoff[queue.destination];
+						bk.failures++;
+						unsigned int delay = limits.retry << std::min(bk.failures - 1,16U);
+						if(delay > limits.maxretry || delay < limits.retry) {
+							delay = limits.maxretry;
+						}
+						bk.next = time(0) + delay;
+						wait = wait ? std::min(wait,(time_t) delay) : delay;
+
+						Logger::String{
+							queue.destination.c_str(),": ",message.c_str(),
+							" (",queue.entries.size() - first - sent," alert(s) kept, retry in ",delay,"s)"
+						}.warning("alerts");
+
+						break;
+
+					}
+
+				}
+
+			}
+
+			{
+				lock_guard<mutex> lock(guard);
+				release();
+			}
+
+			if(queues.empty()) {
+				break;
+			}
+
+		}
+
+		return wait;
+
+	}
+
+ }
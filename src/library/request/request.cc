@@ -29,16 +29,106 @@
  #include <udjat/tools/http/mimetype.h>
  #include <udjat/tools/http/exception.h>
  #include <udjat/tools/configuration.h>
+ #include <udjat/tools/http/timestamp.h>
+ #include <cctype>
 
  namespace Udjat {
 
 	Request::~Request() {
 	}
 
-	bool Request::cached(const TimeStamp &) const {
+	bool Request::cached(const TimeStamp &timestamp) const {
+
+		if(!timestamp) {
+			return false;
+		}
+
+		const char *since = header("If-Modified-Since");
+		if(!(since && *since)) {
+			return false;
+		}
+
+		try {
+
+			// HTTP dates have one second resolution.
+			return ((time_t) timestamp) <= ((time_t) HTTP::TimeStamp{since});
+
+		} catch(const std::exception &e) {
+
+			Logger::String{"Ignoring If-Modified-Since header: ",e.what()}.trace();
+
+		}
+
 		return false;
 	}
 
+	/// @brief Skip the weak validator prefix, If-None-Match uses the weak comparison (RFC 7232, section 3.2).
+	static const char * strong(const char *tag) noexcept {
+		if(tag[0] == 'W' && tag[1] == '/') {
+			return tag+2;
+		}
+		return tag;
+	}
+
+	bool Request::match(const char *etag) const {
+
+		if(!(etag && *etag)) {
+			return false;
+		}
+
+		const char *tags = header("If-None-Match");
+		if(!(tags && *tags)) {
+			return false;
+		}
+
+		etag = strong(etag);
+		size_t length = strlen(etag);
+
+		while(*tags) {
+
+			while(*tags && (isspace(*tags) || *tags == ',')) {
+				tags++;
+			}
+
+			if(!*tags) {
+				break;
+			}
+
+			const char *next = strchr(tags,',');
+			if(!next) {
+				next = tags + strlen(tags);
+			}
+
+			const char *end = next;
+			while(end > tags && isspace(end[-1])) {
+				end--;
+			}
+
+			if(end - tags == 1 && *tags == '*') {
+				return true;
+			}
+
+			const char *tag = strong(tags);
+			if(((size_t) (end - tag)) == length && !strncmp(tag,etag,length)) {
+				return true;
+			}
+
+			tags = next;
+		}
+
+		return false;
+	}
+
+	bool Request::not_modified(const TimeStamp &timestamp, const char *etag) const {
+
+		const char *tags = header("If-None-Match");
+		if(tags && *tags) {
+			return match(etag);
+		}
+
+		return cached(timestamp);
+	}
+
 	const char * Request::query(const char *def) const {
 		return def;
 	}
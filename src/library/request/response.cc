@@ -22,6 +22,7 @@
  #include <udjat/tools/response.h>
  #include <udjat/tools/exception.h>
  #include <udjat/tools/intl.h>
+ #include <private/cbor.h>
  #include <ctime>
  #include <stdexcept>
  #include <sstream>
@@ -57,6 +58,7 @@
 	Response & Response::failed(int syscode) noexcept {
 		status.value = State::Failure;
 		clear(Value::Object);
+		contents.reset();
 		status.message = strerror(syscode);
 		status.code = syscode;
 		return *this;
@@ -70,6 +72,7 @@
 
 		status.value = State::Failure;
 		clear(Value::Object);
+		contents.reset();
 
 		status.message = message;
 		status.code = 0;
@@ -96,6 +99,7 @@
 
 		status.value = State::Failure;
 		clear(Value::Object);
+		contents.reset();
 
 		status.message = e.what();
 		status.title.clear();
@@ -145,6 +149,11 @@
 
 		debug("Serializing response");
 
+		if(contents) {
+			stream << *contents;
+			return;
+		}
+
 		switch(mimetype) {
 		case Udjat::Value::Undefined:
 			throw runtime_error("Unable to serialize undefined value");
@@ -210,6 +219,18 @@
 			to_sh(stream);
 			break;
 
+		case MimeType::cbor:
+			CBOR::head(stream,CBOR::Map,status.message.empty() ? 2 : 3);
+			CBOR::text(stream,"status");
+			CBOR::text(stream,std::to_string(status.value));
+			if(!status.message.empty()) {
+				CBOR::text(stream,"message");
+				CBOR::text(stream,status.message.c_str());
+			}
+			CBOR::text(stream,"data");
+			to_cbor(stream);
+			break;
+
 		default:
 			Value::serialize(stream,mimetype);
 		}
@@ -37,8 +37,14 @@
 
  #ifndef _WIN32
   #include <udjat/tools/system.h>
+  #include <udjat/tools/socket.h>
+  #include <sys/socket.h>
  #endif // !_WIN32
 
+ #ifdef HAVE_IO_URING
+  #include <private/linux/uring.h>
+ #endif // HAVE_IO_URING
+
  #ifdef HAVE_OPENSSL
  #include <udjat/tools/crypto.h>
  #endif // HAVE_OPENSSL
@@ -386,8 +392,162 @@ return 0;
 	return 0;
 
  }
+
+ static int procfile_test() {
+
+	System::ProcFile meminfo{"/proc/meminfo"};
+
+	unsigned long long total = meminfo.as_ull("MemTotal");
+	if(!total) {
+		throw logic_error{"ProcFile test failed: no MemTotal on /proc/meminfo."};
+	}
+
+	if(!meminfo["Mem"].empty()) {
+		throw logic_error{"ProcFile test failed: 'Mem' should not match 'MemTotal'."};
+	}
+
+	// Read again, the values must come from the new contents.
+	if(meminfo.refresh().as_ull("MemTotal") != total) {
+		throw logic_error{"ProcFile test failed: MemTotal changed after refresh."};
+	}
+
+	System::ProcFile stat{"/proc/stat",' '};
+	unsigned long long cpu[4];
+	if(stat.get("cpu",cpu,4) != 4) {
+		throw logic_error{"ProcFile test failed: Cant parse the 'cpu' line of /proc/stat."};
+	}
+
+	Logger::String{"ProcFile seens ok, MemTotal is ",total," kB"}.info();
+	return 0;
+
+ }
+
+ static int socket_test() {
+
+	class Framed : public Socket {
+	public:
+		std::vector<std::string> frames;
+		int error = 0;
+
+		Framed(int fd) : Socket{fd} {
+			limit(64);
+		}
+
+		void handle_read_ok() override {
+			try {
+				std::string frame;
+				while(read(frame,"\r\n")) {
+					frames.push_back(frame);
+				}
+			} catch(const std::system_error &e) {
+				error = e.code().value();
+			}
+		}
+
+		inline void input() {
+			handle_event(MainLoop::Handler::oninput);
+		}
+
+		inline size_t unread() const noexcept {
+			return available();
+		}
+
+	};
+
+	int sv[2];
+	if(socketpair(AF_UNIX,SOCK_STREAM,0,sv)) {
+		throw system_error(errno,system_category(),"Cant create socket pair");
+	}
+
+	Framed framed{sv[1]};
+
+	static const char *text = "first\r\nsecond\r\nthi";
+	if(::write(sv[0],text,strlen(text)) < 0) {
+		::close(sv[0]);
+		throw system_error(errno,system_category(),"Cant write to socket");
+	}
+
+	framed.input();
+
+	if(framed.frames.size() != 2 || framed.frames[1] != "second" || framed.unread() != 3) {
+		::close(sv[0]);
+		throw logic_error{"Socket test failed: unexpected frames."};
+	}
+
+	// No delimiter up to the input limit, the frame can't be read.
+	std::string overflow(100,'x');
+	if(::write(sv[0],overflow.c_str(),overflow.size()) < 0) {
+		::close(sv[0]);
+		throw system_error(errno,system_category(),"Cant write to socket");
+	}
+
+	framed.input();
+	::close(sv[0]);
+
+	if(framed.error != EMSGSIZE) {
+		throw logic_error{"Socket test failed: oversized frame was not detected."};
+	}
+
+	Logger::String{"Socket framing seens ok"}.info();
+	return 0;
+
+ }
 #endif // !_WIN32
 
+#ifdef HAVE_IO_URING
+ static int uring_test() {
+
+	URing *uring = URing::getInstance();
+	if(!uring) {
+		Logger::String{"io_uring engine is not available, skipping test"}.info();
+		return 0;
+	}
+
+	// Not aligned to the block size, the last block is partial.
+	std::vector<char> contents(1048576 + 1234);
+	for(size_t ix = 0; ix < contents.size(); ix++) {
+		contents[ix] = (char) (ix % 251);
+	}
+
+	int from = File::Temporary::open(100);
+	int to = File::Temporary::open(100);
+
+	try {
+
+		if(pwrite(from,contents.data(),contents.size(),0) != (ssize_t) contents.size()) {
+			throw system_error(errno,system_category(),"Cant write source file");
+		}
+
+		uint64_t copied = uring->copy(from,0,to,0,UINT64_MAX,65536,nullptr);
+		if(copied != contents.size()) {
+			throw logic_error{"io_uring test failed: unexpected copy length."};
+		}
+
+		// Read back with a batch.
+		std::vector<char> check(contents.size());
+		URing::Batch batch;
+		batch.read(to,check.data(),check.size(),0);
+		batch.run();
+
+		if(batch[0] != (int) check.size() || check != contents) {
+			throw logic_error{"io_uring test failed: the copy doesn't match the source."};
+		}
+
+	} catch(...) {
+		::close(from);
+		::close(to);
+		throw;
+	}
+
+	::close(from);
+	::close(to);
+
+	Logger::String{"io_uring copy seens ok"}.info();
+	return 0;
+
+ }
+#endif // HAVE_IO_URING
+
  UDJAT_API int run_udjat_unit_test(const char *name) {
 
 	static const struct {
@@ -396,7 +556,12 @@ return 0;
 	} tests[] = {
 #ifndef _WIN32
 		{"sysconfig",	sysconfig_test},
+		{"procfile",	procfile_test},
+		{"socket",		socket_test},
 #endif
+#ifdef HAVE_IO_URING
+		{"uring",		uring_test},
+#endif // HAVE_IO_URING
 #if defined(HAVE_IBMTSS) && defined(HAVE_OPENSSL)
 		{"tpm",	tpm_test},
 #endif 		
@@ -36,6 +36,7 @@
  #include <udjat/agent/abstract.h>
  #include <private/agent.h>
  #include <private/service.h>
+ #include <private/registry.h>
 
  #undef LOG_DOMAIN
  #define LOG_DOMAIN Application::Name();
@@ -109,6 +110,7 @@
 				// TODO: Load XML definitions.
 				root = RootFactory();
 				time_t refresh = root->parse(path);
+				Abstract::Registry::trace();
 
 				if(refresh) {
 
@@ -37,6 +37,10 @@
  #endif // _GNU_SOURCE
  #include <fcntl.h>
 
+ #ifdef HAVE_IO_URING
+	#include <private/linux/uring.h>
+ #endif // HAVE_IO_URING
+
  using namespace std;
 
  namespace Udjat {
@@ -215,6 +219,16 @@
 		}
 
 		size_t bsize = file.block_size();
+
+#ifdef HAVE_IO_URING
+		URing *uring = URing::getInstance();
+		if(uring) {
+			// Copy until EOF, writing each block while the next one is read.
+			uring->copy(file.fd,from,fd,to,UINT64_MAX,bsize,nullptr);
+			return;
+		}
+#endif // HAVE_IO_URING
+
 		char buffer[bsize];
 	
 		while(ssize_t bytes = pread(file.fd,buffer,bsize,from)) {
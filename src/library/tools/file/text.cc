@@ -0,0 +1,104 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements the platform independent parts of the text file.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/file/text.h>
+ #include <system_error>
+ #include <cstring>
+ #include <cstdlib>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	File::Text & File::Text::set(const char *text, size_t len) {
+
+		// Copy before unload, text could be a view on the current contents.
+		char *buffer = (char *) malloc(len+1);
+		if(!buffer) {
+			throw system_error(ENOMEM,system_category(),"Cant allocate text buffer");
+		}
+		memcpy(buffer,text,len);
+		buffer[len] = 0;
+
+		unload();
+		this->contents = buffer;
+		this->length = len;
+
+		return *this;
+	}
+
+	void File::Text::for_each(std::function<void (const std::string &line)> call) const {
+
+		if(!contents) {
+			return;
+		}
+
+		for(std::string_view line : lines()) {
+			call(std::string{line});
+		}
+
+		if(!length || contents[length-1] == '\n') {
+			call(std::string{});
+		}
+
+	}
+
+	File::Text::Lines::Iterator::Iterator(const char *p, const char *l, char d) noexcept : ptr{p}, eol{l}, limit{l}, delimiter{d} {
+		if(ptr < limit) {
+			// memchr() is vectorized by the C library.
+			const char *next = (const char *) memchr(ptr,delimiter,limit-ptr);
+			eol = next ? next : limit;
+		}
+	}
+
+	File::Text::Lines::Iterator & File::Text::Lines::Iterator::operator++() noexcept {
+
+		ptr = (eol < limit) ? eol+1 : limit;
+
+		if(ptr < limit) {
+			const char *next = (const char *) memchr(ptr,delimiter,limit-ptr);
+			eol = next ? next : limit;
+		} else {
+			eol = limit;
+		}
+
+		return *this;
+	}
+
+	File::Text::Lines::Iterator File::Text::Lines::Iterator::operator++(int) noexcept {
+		Iterator tmp = *this;
+		++(*this);
+		return tmp;
+	}
+
+	File::Text::Lines::Iterator File::Text::Lines::begin() const noexcept {
+		return Iterator{text,text+length,delimiter};
+	}
+
+	File::Text::Lines::Iterator File::Text::Lines::end() const noexcept {
+		return Iterator{text+length,text+length,delimiter};
+	}
+
+ }
@@ -28,11 +28,11 @@
 
  namespace Udjat {
 
-	File::Watcher::Watcher(const char *p) : pathname{p} {
+	File::Watcher::Watcher(const char *p, bool r) : pathname{p}, recursive{r} {
 	}
 
 	File::Watcher::Watcher(const XML::Node &node, const char *attrname)
-		: File::Watcher{String{node,attrname,""}.as_quark()} {
+		: File::Watcher{String{node,attrname,""}.as_quark(),node.attribute("recursive").as_bool(false)} {
 
 		if(node.attribute("watch-file-changes").as_bool(true)) {
 			watch();
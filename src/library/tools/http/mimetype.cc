@@ -76,6 +76,12 @@
 	// Form parser
 	{ "form-urlencoded",	"x-www-form-urlencoded" },
 
+	// https://github.com/prometheus/OpenMetrics/blob/main/specification/OpenMetrics.md
+	{ "metrics",	"application/openmetrics-text; version=1.0.0; charset=utf-8" },
+
+	// https://www.rfc-editor.org/rfc/rfc8949
+	{ "cbor",	"application/cbor" },
+
  };
 
  const char * std::to_string(const Udjat::MimeType type, bool suffix) {
@@ -28,14 +28,15 @@
  #include <udjat/tools/string.h>
  #include <udjat/tools/logger.h>
  #include <udjat/tools/xml.h>
+ #include <private/registry.h>
 
  using namespace std;
 
  namespace Udjat {
 
-	class UDJAT_PRIVATE InterfaceFactories : public Container<Interface::Factory>, public XML::Parser {
+	class UDJAT_PRIVATE InterfaceFactories : public Registry<Interface::Factory>, public XML::Parser {
 	public:
-		InterfaceFactories() : XML::Parser{"interface"} {
+		InterfaceFactories() : Registry<Interface::Factory>{"interfaces"}, XML::Parser{"interface"} {
 			debug("Interface factories initialized");
 		}
 
@@ -83,37 +84,36 @@
 
 		for(String &name : String{node,"type"}.split(",")) {
 
-			for(auto &factory : Factories()) {
+			bool all = (strcmp(name.c_str(),"*") == 0 || strcasecmp(name.c_str(),"all") == 0);
 
-				if(strcmp(name.c_str(),"*") == 0 || strcasecmp(name.c_str(),"all") == 0 || *factory == name.c_str()) {
+			for(auto factory : (all ? Factories().list() : Factories().find(name.c_str()))) {
 
-					try {
+				try {
 
-						Interface &intf = factory->InterfaceFactory(node);
+					Interface &intf = factory->InterfaceFactory(node);
+					Factories().count(factory->name(),factory);
 
-						if(action) {
-							intf.push_back(node,action);
-						}
+					if(action) {
+						intf.push_back(node,action);
+					}
 
-						// Insert handlers
-						for(auto hdl = node.child("handler"); hdl; hdl = hdl.next_sibling("handler")) {
-							auto &handler = intf.push_back(hdl);
-							for(const char *nodename : { "action", "script" }) {
-								for(auto act = hdl.child(nodename); hdl; hdl = hdl.next_sibling(nodename)) {
-									handler.push_back(act);
-								}
+					// Insert handlers
+					for(auto hdl = node.child("handler"); hdl; hdl = hdl.next_sibling("handler")) {
+						auto &handler = intf.push_back(hdl);
+						for(const char *nodename : { "action", "script" }) {
+							for(auto act = hdl.child(nodename); hdl; hdl = hdl.next_sibling(nodename)) {
+								handler.push_back(act);
 							}
 						}
+					}
 
-					} catch(const std::exception &e) {
-
-						Logger::String{e.what()}.error(factory->name());
+				} catch(const std::exception &e) {
 
-					} catch(...) {
+					Logger::String{e.what()}.error(factory->name());
 
-						Logger::String{"Unexpected error building interface"}.error(factory->name());
+				} catch(...) {
 
-					}
+					Logger::String{"Unexpected error building interface"}.error(factory->name());
 
 				}
 
@@ -128,15 +128,15 @@
 	}
 
 	Interface::Factory::Factory(const char *name, const char *description) : factory_name{name}, factory_description{description} {
-		Factories().push_back(this);
+		Factories().insert(factory_name,this);
 	}
 
 	Interface::Factory::~Factory() {
-		Factories().remove(this);
+		Factories().remove(factory_name,this);
 	}
 
 	bool Interface::Factory::for_each(const std::function<bool(Interface::Factory &intf)> &method) {
-		for(Interface::Factory *intf : Factories()) {
+		for(Interface::Factory *intf : Factories().list()) {
 			if(method(*intf)) {
 				return true;
 			} 
@@ -27,6 +27,7 @@
 	#include <private/win32/mainloop.h>
  #else
 	#include <private/linux/mainloop.h>
+	#include <private/event.h>
  #endif // _WIN32
 
  #ifdef HAVE_SYSTEMD
@@ -44,9 +45,17 @@
 			throw system_error(EBUSY,system_category(),"Mainloop was already set");
 		}
 		instance = this;
+#ifndef _WIN32
+		// Block the managed signals before starting any thread, they're read from a signalfd.
+		Event::Controller::block();
+		Event::Controller::getInstance().attach(this);
+#endif // _WIN32
 	}
 
 	MainLoop::~MainLoop() {
+#ifndef _WIN32
+		Event::Controller::getInstance().detach(this);
+#endif // _WIN32
 		if(instance == this) {
 			instance = nullptr;
 		}
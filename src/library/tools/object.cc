@@ -32,7 +32,8 @@
  #include <udjat/module/abstract.h>
  #include <udjat/action.h>
  #include <udjat/tools/interface.h>
- #include <udjat/tools/container.h>
+ #include <private/registry.h>
+ #include <private/xml.h>
 
  #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
   
@@ -40,17 +41,17 @@
 
  namespace Udjat {
 
-	static Container<Abstract::Object::Factory> & Factories() {
-		static Container<Abstract::Object::Factory> instance;
+	static Registry<Abstract::Object::Factory> & Factories() {
+		static Registry<Abstract::Object::Factory> instance{"objects"};
 		return instance;
 	}
 
 	Abstract::Object::Factory::Factory(const char *n) : name{n} {
-		Factories().push_back(this);
+		Factories().insert(name,this);
 	}
 
 	Abstract::Object::Factory::~Factory() {
-		Factories().remove(this);
+		Factories().remove(name,this);
 	}
 
 	std::shared_ptr<Abstract::Object> Abstract::Object::Factory::ObjectFactory(Abstract::Object &parent, const XML::Node &node) const {
@@ -205,22 +206,13 @@
 			debug("Node name for '",node.path()," is '",name,"'");
 
 			// Is it a factory?
-			for(const auto factory : Factories()) {
-
-				if(*factory == name) {
-/*
-#ifndef BUILD_LEGACY
-					if(trace) {
-						Logger::String{"Got factory '", factory->c_str(), "' for ",child.path()}.info(this->name());
-					}
-#endif
-*/
-
-					auto object = factory->ObjectFactory(child);
-					push_back(child,object);
-					object->parse_children(child);
-					break; 
-				}
+			auto factories = Factories().find(name);
+			if(!factories.empty()) {
+				auto factory = factories.front();
+				auto object = factory->ObjectFactory(child);
+				Factories().count(name,factory);
+				push_back(child,object);
+				object->parse_children(child);
 			}
 
 		}
@@ -379,9 +371,12 @@
 
 	void Abstract::Object::for_each(const XML::Node &root, const char *name, const char *group, const std::function<void(const XML::Node &node)> &handler) {
 
-		for(XML::Node node = root.child(name); node; node = node.next_sibling(name)) {
+		auto call = [&handler](const XML::Node &node){
 			handler(node);
-		}
+			return false;
+		};
+
+		XML::Index::for_each(root,name,call);
 
 		if(group && *group) {
 
@@ -396,18 +391,13 @@
 			for(XML::Node parent = root.parent(); parent; parent = parent.parent()) {
 
 				// Scan for nodes.
-				for(XML::Node node = parent.child(node_name.c_str()); node; node = node.next_sibling(node_name.c_str())) {
-					handler(node);
-				}
+				XML::Index::for_each(parent,node_name.c_str(),call);
 
 				// Scan for groups.
-				for(XML::Node grp = parent.child(group_name.c_str()); grp; grp = grp.next_sibling(group_name.c_str())) {
-
-					for(XML::Node node = grp.child(name); node; node = node.next_sibling(name)) {
-						handler(node);
-					}
-
-				}
+				XML::Index::for_each(parent,group_name.c_str(),[name,&call](const XML::Node &grp){
+					XML::Index::for_each(grp,name,call);
+					return false;
+				});
 
 			}
 
@@ -451,13 +441,9 @@
 
 		for(XML::Node n = node; n && !rc; n = n.parent()) {
 
-			for(XML::Node child = n.child(tagname); child && !rc; child = child.next_sibling(tagname)) {
-
-				if(is_allowed(child)) {
-					rc = call(child);
-				}
-
-			}
+			rc = XML::Index::for_each(n,tagname,[&call](const XML::Node &child){
+				return is_allowed(child) && call(child);
+			});
 
 		}
 
@@ -549,10 +535,8 @@
 	bool Abstract::Object::search(const XML::Node &node, const char *tagname, const std::function<bool(const XML::Node &node)> &call) {
 
 		for(XML::Node nd = node; nd; nd = nd.parent()) {
-			for(XML::Node child = nd.child(tagname); child; child = child.next_sibling(tagname)) {
-				if(call(child)) {
-					return true;
-				}
+			if(XML::Index::for_each(nd,tagname,call)) {
+				return true;
 			}
 		}
 
@@ -619,21 +603,21 @@
 					continue; // Handled by action.
 				}
 
-				for(const auto factory : Factories()) {
+				auto factories = Factories().find(name);
+				if(!factories.empty()) {
+
+					auto factory = factories.front();
 
-					if(*factory == name) {
-		
 #ifndef BUILD_LEGACY
-						if(Logger::enabled(Logger::Debug)) {
-							Logger::String{"Got factory '", factory->c_str(), "' for ",node.path()}.info(this->name());
-						}
+					if(Logger::enabled(Logger::Debug)) {
+						Logger::String{"Got factory '", factory->c_str(), "' for ",node.path()}.info(this->name());
+					}
 #endif
 
-						auto object = factory->ObjectFactory(node);
-						push_back(node,object);
-						object->parse_children(node);
-						break; 
-					}
+					auto object = factory->ObjectFactory(node);
+					Factories().count(name,factory);
+					push_back(node,object);
+					object->parse_children(node);
 				}
 
 			}
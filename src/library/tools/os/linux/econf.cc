@@ -35,6 +35,8 @@
  #include <udjat/tools/logger.h>
 
  #include <private/configuration.h>
+ #include <udjat/tools/event.h>
+ #include <cstring>
 
  namespace Udjat {
 
@@ -45,9 +47,9 @@
 	}
 #endif
 
-	static void handle_reload(int sig) noexcept {
+	static bool handle_reload() noexcept {
 
-		Logger::String{"Reloading configuration by signal '",(const char *) strsignal(sig),"'"}.write(Logger::Trace);
+		Logger::String{"Reloading configuration by signal '",(const char *) strsignal(SIGHUP),"'"}.write(Logger::Trace);
 
 		try {
 
@@ -63,17 +65,19 @@
 
 		}
 
+		return true;
+
 	}
 
 	std::recursive_mutex Config::Controller::guard;
 
 	Config::Controller::Controller() {
 		open();
-		signal(SIGHUP,handle_reload);
+		Event::SignalHandler(this,SIGHUP,handle_reload);
 	}
 
 	Config::Controller::~Controller() {
-		signal(SIGHUP,SIG_DFL);
+		Event::remove(this);
 		close();
 	}
 
@@ -55,7 +55,16 @@
 		Logger::String{
 			"Watching ",(const char *) strsignal(signum)," (",signum,")"
 		}.write(Logger::Debug,"signal");
-		signal(signum,Controller::onSignal);
+
+		// The managed signals are read from the dispatcher's signalfd, this handler catches
+		// the other signals and the ones delivered to threads not blocking them.
+		struct sigaction action;
+		memset(&action,0,sizeof(action));
+		sigemptyset(&action.sa_mask);
+		action.sa_sigaction = Controller::onSignal;
+		action.sa_flags = SA_SIGINFO|SA_RESTART;
+		sigaction(signum,&action,NULL);
+
 	}
 
 	Event::Controller::Signal::~Signal() {
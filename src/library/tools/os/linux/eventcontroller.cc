@@ -21,7 +21,13 @@
  #include <iostream>
  #include <cstring>
  #include <csignal>
- #include <udjat/tools/threadpool.h>
+ #include <sys/signalfd.h>
+ #include <unistd.h>
+ #include <fcntl.h>
+ #include <poll.h>
+ #include <pthread.h>
+ #include <chrono>
+ #include <system_error>
  #include <udjat/tools/logger.h>
 
  using namespace std;
@@ -74,27 +80,231 @@
 
 	}
 
-	void Event::Controller::onSignal(int signum) noexcept {
+	static void managed(sigset_t &mask) noexcept {
+		sigemptyset(&mask);
+		sigaddset(&mask,SIGHUP);
+		sigaddset(&mask,SIGINT);
+		sigaddset(&mask,SIGTERM);
+		sigaddset(&mask,SIGUSR1);
+		sigaddset(&mask,SIGUSR2);
+	}
+
+	void Event::Controller::block() noexcept {
+		sigset_t mask;
+		managed(mask);
+		pthread_sigmask(SIG_BLOCK,&mask,NULL);
+	}
+
+	void Event::Controller::attach(MainLoop *loop) noexcept {
+		lock_guard<recursive_mutex> lock(guard);
+		mainloop = loop;
+	}
+
+	void Event::Controller::detach(MainLoop *loop) noexcept {
+		lock_guard<recursive_mutex> lock(guard);
+		if(mainloop == loop) {
+			mainloop = nullptr;
+		}
+	}
+
+	void Event::Controller::onSignal(int signum, siginfo_t *, void *) noexcept {
+
+		// Async signal context: just wake the dispatcher.
+		Dispatcher::wakeup(signum);
+
+	}
+
+	void Event::Controller::post(int signum) noexcept {
+
+		lock_guard<recursive_mutex> lock(guard);
+
+		bool listened = false;
+		for(Signal &signal : signals) {
+			if(signal.signum == signum) {
+				listened = true;
+			}
+		}
+
+		if(!listened) {
+
+			sigset_t mask;
+			managed(mask);
+			if(sigismember(&mask,signum) != 1) {
+				return;
+			}
+
+			// Nobody is listening, apply the current disposition of the managed signal.
+			Logger::String{
+				"Signal '",(const char *) strsignal(signum),"' (",signum,") has no listeners"
+			}.trace("signals");
+
+			sigemptyset(&mask);
+			sigaddset(&mask,signum);
+			pthread_sigmask(SIG_UNBLOCK,&mask,NULL);
+			raise(signum);
+			pthread_sigmask(SIG_BLOCK,&mask,NULL);
+			return;
+
+		}
+
+		if(mainloop && mainloop->active()) {
+
+			class Message : public MainLoop::Message {
+			private:
+				int signum;
+
+			public:
+				Message(int s) : signum{s} {
+				}
+
+				void execute() override {
+					getInstance().dispatch(signum);
+				}
+
+			};
 
-		// Move signal processing to another thread to avoid dead locks.
-		ThreadPool::getInstance().push("SignalHandler",[signum](){
-			cout << "signals\tProcessing signal '" << strsignal(signum) << "' (" << signum << ")" << endl;
+			mainloop->post(new Message{signum});
+			return;
 
-			Controller &instance = getInstance();
+		}
+
+		// No main loop, run the listeners on the dispatcher thread.
+		dispatch(signum);
+
+	}
+
+	void Event::Controller::dispatch(int signum) noexcept {
+
+		Logger::String{
+			"Processing signal '",(const char *) strsignal(signum),"' (",signum,")"
+		}.trace("signals");
 
-			{
-				lock_guard<recursive_mutex> lock(guard);
-				for(Signal &signal : instance.signals) {
-					if(signal.signum == signum) {
-						ThreadPool::getInstance().push("signal-event",[&signal]() {
-							signal.trigger();
-						});
+		lock_guard<recursive_mutex> lock(guard);
+		for(Signal &signal : signals) {
+			if(signal.signum == signum) {
+				signal.trigger();
+			}
+		}
+
+	}
+
+	int Event::Controller::Dispatcher::pipes[2] = { -1, -1 };
+
+	Event::Controller::Dispatcher::Dispatcher(Controller &c) : controller{c} {
+
+		// Also blocks the dispatcher thread when there's no main loop.
+		block();
+
+		sigset_t mask;
+		managed(mask);
+
+		sfd = signalfd(-1,&mask,SFD_NONBLOCK|SFD_CLOEXEC);
+		if(sfd < 0) {
+			throw system_error(errno,system_category(),"Cant create signalfd");
+		}
+
+		if(pipe2(pipes,O_NONBLOCK|O_CLOEXEC)) {
+			int err = errno;
+			::close(sfd);
+			throw system_error(err,system_category(),"Cant create signal pipe");
+		}
+
+		thread = std::thread{[this](){
+			run();
+		}};
+
+	}
+
+	Event::Controller::Dispatcher::~Dispatcher() {
+
+		// Set before waking, the thread could be waiting for a guard held by the caller.
+		stopping = true;
+		wakeup(0);
+
+		if(thread.get_id() == this_thread::get_id()) {
+			thread.detach();	// Process exiting from a signal listener.
+		} else if(thread.joinable()) {
+			thread.join();
+		}
+
+		::close(sfd);
+
+	}
+
+	void Event::Controller::Dispatcher::wakeup(int signum) noexcept {
+		int err = errno;
+		if(pipes[1] >= 0) {
+			unsigned char byte = (unsigned char) signum;
+			if(::write(pipes[1],&byte,1) < 0) {
+				// Pipe is full, the dispatcher is already awake.
+			}
+		}
+		errno = err;
+	}
+
+	void Event::Controller::Dispatcher::run() noexcept {
+
+		struct pollfd pfd[2];
+		memset(pfd,0,sizeof(pfd));
+		pfd[0].fd = sfd;
+		pfd[0].events = POLLIN;
+		pfd[1].fd = pipes[0];
+		pfd[1].events = POLLIN;
+
+		bool running = true;
+		while(running) {
+
+			if(poll(pfd,2,-1) < 0) {
+				if(errno == EINTR) {
+					continue;
+				}
+				Logger::String{"Error polling signal descriptors: ",strerror(errno)}.error("signals");
+				break;
+			}
+
+			// Coalesce the pending signals, every listener runs once per wakeup.
+			uint64_t pending = 0;
+
+			struct signalfd_siginfo info[16];
+			ssize_t bytes;
+			while((bytes = ::read(sfd,info,sizeof(info))) > 0) {
+				for(size_t ix = 0; ix < (bytes / sizeof(info[0])); ix++) {
+					if(info[ix].ssi_signo > 0 && info[ix].ssi_signo <= 64) {
+						pending |= ((uint64_t) 1) << (info[ix].ssi_signo - 1);
 					}
 				}
 			}
-		});
+
+			unsigned char signals[16];
+			while((bytes = ::read(pipes[0],signals,sizeof(signals))) > 0) {
+				for(ssize_t ix = 0; ix < bytes; ix++) {
+					if(!signals[ix]) {
+						running = false;
+					} else if(signals[ix] <= 64) {
+						pending |= ((uint64_t) 1) << (signals[ix] - 1);
+					}
+				}
+			}
+
+			for(int signum = 1; running && pending; signum++, pending >>= 1) {
+				if(pending & 1) {
+
+					// Don't block on the guard, the destructor could be joining this thread while holding it.
+					while(!guard.try_lock()) {
+						if(stopping) {
+							return;
+						}
+						this_thread::sleep_for(chrono::milliseconds(10));
+					}
+
+					controller.post(signum);
+					guard.unlock();
+
+				}
+			}
+
+		}
 
 	}
 
  }
-
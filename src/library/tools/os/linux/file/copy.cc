@@ -29,6 +29,10 @@
  #include <libgen.h>
  #include <limits.h>
 
+ #ifdef HAVE_IO_URING
+	#include <private/linux/uring.h>
+ #endif // HAVE_IO_URING
+
  using namespace std;
 
  namespace Udjat {
@@ -41,34 +45,51 @@
 		}
 
 		size_t buflen = (st.st_blksize * 2);
-		char buffer[buflen];
-
-		size_t saved = 0;
 
 		if(progress(0,0)) {
 			throw system_error(ECANCELED,system_category());
 		}
 
-		while(saved < (size_t) st.st_size) {
+#ifdef HAVE_IO_URING
+		URing *uring = URing::getInstance();
+		if(uring) {
+
+			// Overlap the write of each block with the read of the next one.
+			uint64_t saved = uring->copy(from,0,to,0,st.st_size,buflen,[&progress,&st](uint64_t copied){
+				return progress((double) copied,(double) st.st_size);
+			});
 
-			ssize_t bytes = ::read(from,buffer,buflen);
-			if(bytes == 0) {
+			if(saved < (uint64_t) st.st_size) {
 				clog << "Unexpected EOF reading from input file" << endl;
-				break;
 			}
 
-			if(bytes < 0) {
-				throw system_error(errno,system_category());
-			}
+		} else
+#endif // HAVE_IO_URING
+		{
+			char buffer[buflen];
+			size_t saved = 0;
 
-			if(::write(to,buffer,bytes) != bytes) {
-				throw system_error(errno,system_category());
-			}
+			while(saved < (size_t) st.st_size) {
+
+				ssize_t bytes = ::read(from,buffer,buflen);
+				if(bytes == 0) {
+					clog << "Unexpected EOF reading from input file" << endl;
+					break;
+				}
+
+				if(bytes < 0) {
+					throw system_error(errno,system_category());
+				}
+
+				if(::write(to,buffer,bytes) != bytes) {
+					throw system_error(errno,system_category());
+				}
 
-			saved += bytes;
+				saved += bytes;
 
-			if(progress((double) saved,(double) st.st_size)) {
-				throw system_error(ECANCELED,system_category());
+				if(progress((double) saved,(double) st.st_size)) {
+					throw system_error(ECANCELED,system_category());
+				}
 			}
 		}
 
@@ -43,7 +43,12 @@
 			this->separator = '=';
 	 	}
 
-		set(Udjat::File::Text(filename).c_str());
+		if(!(strncmp(filename,"/proc/",6) && strncmp(filename,"/sys/",5))) {
+			// Pseudo file, can't be mapped.
+			set(ProcFile{filename,this->separator}.c_str());
+		} else {
+			set(Udjat::File::Text(filename).c_str());
+		}
 	}
 
 	std::string System::Config::File::name() const {
@@ -76,7 +81,7 @@
 
 	System::Config::File::Value System::Config::File::find(const char *key) const noexcept {
 
-		for(auto value : values) {
+		for(const auto &value : values) {
 			if(!strcasecmp(value.name.c_str(),key))
 				return value;
 		}
@@ -85,7 +90,7 @@
 	}
 
 	void System::Config::File::forEach(std::function<void(const System::Config::File::Value &value)> callback) const {
-		for(auto value : values) {
+		for(const auto &value : values) {
 			callback(value);
 		}
 	}
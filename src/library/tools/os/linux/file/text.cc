@@ -26,6 +26,7 @@
  #include <fcntl.h>
  #include <unistd.h>
  #include <libgen.h>
+ #include <cstring>
  #include <iostream>
 
  #include "private.h"
@@ -102,10 +103,17 @@
 			return *this;
 		}
 
-		String text{contents};
+		// Nothing to expand, keep the contents (and the mapping) as they are.
+		if(!memchr(contents,marker,length)) {
+			return *this;
+		}
+
+		// The contents could be a read only mapping, expand a copy and store the result
+		// with its known length (no strlen() or strdup() passes).
+		String text{(const char *) contents,length};
 		text.expand(marker,dynamic,cleanup);
 
-		return set(text.c_str());
+		return set(text.c_str(),text.size());
 
 	}
 
@@ -115,10 +123,14 @@
 			return *this;
 		}
 
-		String text{contents};
+		if(!memchr(contents,marker,length)) {
+			return *this;
+		}
+
+		String text{(const char *) contents,length};
 		text.expand(marker,expander,dynamic,cleanup);
 
-		return set(text.c_str());
+		return set(text.c_str(),text.size());
 	}
 #else
 	File::Text & File::Text::expand(const std::function<bool(const char *key, std::string &str)> &expander, bool dynamic, bool cleanup) {
@@ -126,10 +138,10 @@
 			return *this;
 		}
 
-		String text{contents};
+		String text{(const char *) contents,length};
 		text.expand(expander,dynamic,cleanup);
 
-		return set(text.c_str());
+		return set(text.c_str(),text.size());
 	}
 #endif // __cplusplus >= 201703L
 
@@ -236,13 +248,14 @@
 			return *this;
 		}
 
+		// The mapped contents aren't nul terminated.
 		const char *from = (this->text + this->offset);
-		const char *to = strchr(from,'\n');
+		const char *to = (const char *) memchr(from,'\n',this->length - this->offset);
 
 		if(to) {
-			value = string(from,to-from);
+			value.assign(from,to-from);
 		} else {
-			value = string(from);
+			value.assign(from,this->length - this->offset);
 		}
 
 		return *this;
@@ -251,7 +264,7 @@
 
 	File::Text::Iterator & File::Text::Iterator::operator++() {
 
-		const char * from = strchr((text+offset),'\n');
+		const char * from = (const char *) memchr((text+offset),'\n',length-offset);
 
 		if(from) {
 			from++;
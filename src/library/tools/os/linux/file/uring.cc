@@ -0,0 +1,762 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+ /**
+  * @brief Implements the io_uring file I/O engine.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <private/linux/uring.h>
+ #include <udjat/tools/configuration.h>
+ #include <udjat/tools/logger.h>
+ #include <linux/io_uring.h>
+ #include <sys/syscall.h>
+ #include <sys/eventfd.h>
+ #include <sys/mman.h>
+ #include <unistd.h>
+ #include <fcntl.h>
+ #include <system_error>
+ #include <algorithm>
+ #include <cstring>
+ #include <climits>
+ #include <chrono>
+
+#ifdef HAVE_IO_URING
+
+ using namespace std;
+
+ namespace Udjat {
+
+	static int io_uring_setup(unsigned int entries, struct io_uring_params *params) {
+		return (int) syscall(__NR_io_uring_setup, entries, params);
+	}
+
+	static int io_uring_enter(int fd, unsigned int to_submit, unsigned int min_complete, unsigned int flags) {
+		return (int) syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0);
+	}
+
+	static int io_uring_register(int fd, unsigned int opcode, const void *arg, unsigned int nr_args) {
+		return (int) syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+	}
+
+	struct URing::Request {
+		Callback call;
+		std::string path;	///< @brief Path for openat/statx, must be valid until the completion.
+		bool async;
+	};
+
+	/// @brief Deliver an asynchronous completion on the main loop.
+	class UDJAT_PRIVATE Completion : public MainLoop::Message {
+	private:
+		URing::Callback call;
+		int result;
+
+	public:
+		Completion(const URing::Callback &c, int r) : call{c}, result{r} {
+		}
+
+		void execute() override {
+			call(result);
+		}
+
+	};
+
+	URing * URing::getInstance() noexcept {
+
+		// Never deleted, async requests can be completed while the application exits.
+		static URing *instance = []() -> URing * {
+
+			// Enabled by default, the kernel support is checked below.
+			if(!Config::Value<bool>("file","io-uring",true).get()) {
+				Logger::String{"io_uring engine was disabled by configuration"}.trace("file");
+				return nullptr;
+			}
+
+			try {
+
+				URing *uring = new URing();
+				Logger::String{"Using io_uring engine with ",uring->sq.entries," entries"}.trace("file");
+				return uring;
+
+			} catch(const std::exception &e) {
+
+				Logger::String{"io_uring engine is not available: ",e.what()}.trace("file");
+
+			}
+
+			return nullptr;
+
+		}();
+
+		if(instance && instance->failed.load(std::memory_order_relaxed)) {
+			return nullptr;
+		}
+
+		return instance;
+
+	}
+
+	URing::URing() {
+
+		struct io_uring_params params;
+		memset(&params,0,sizeof(params));
+
+		ring = io_uring_setup(Config::Value<unsigned int>("file","io-uring-entries",64).get(),&params);
+		if(ring < 0) {
+			throw system_error(errno,system_category(),"Cant setup io_uring");
+		}
+
+		try {
+
+			// Without NODROP completions could be lost when the completion ring is full.
+			if(!(params.features & IORING_FEAT_NODROP)) {
+				throw system_error(ENOTSUP,system_category(),"No IORING_FEAT_NODROP");
+			}
+
+			// Check the required operations.
+			{
+				size_t length = sizeof(struct io_uring_probe) + (256 * sizeof(struct io_uring_probe_op));
+				std::vector<uint8_t> buffer(length,0);
+				struct io_uring_probe *probe = (struct io_uring_probe *) buffer.data();
+
+				if(io_uring_register(ring,IORING_REGISTER_PROBE,probe,256) < 0) {
+					throw system_error(errno,system_category(),"Cant probe io_uring");
+				}
+
+				for(uint8_t opcode : { IORING_OP_READ, IORING_OP_WRITE, IORING_OP_OPENAT, IORING_OP_FSYNC, IORING_OP_STATX }) {
+					if(opcode > probe->last_op || !(probe->ops[opcode].flags & IO_URING_OP_SUPPORTED)) {
+						throw system_error(ENOTSUP,system_category(),"Required io_uring operation is not supported");
+					}
+				}
+			}
+
+			// Map the rings.
+			mappings[0].length = params.sq_off.array + (params.sq_entries * sizeof(unsigned int));
+			mappings[1].length = params.cq_off.cqes + (params.cq_entries * sizeof(struct io_uring_cqe));
+			mappings[2].length = params.sq_entries * sizeof(struct io_uring_sqe);
+
+			if(params.features & IORING_FEAT_SINGLE_MMAP) {
+				mappings[0].length = std::max(mappings[0].length,mappings[1].length);
+				mappings[1].length = 0;
+			}
+
+			static const off_t offsets[] = { IORING_OFF_SQ_RING, IORING_OFF_CQ_RING, IORING_OFF_SQES };
+			for(size_t ix = 0; ix < 3; ix++) {
+				if(!mappings[ix].length) {
+					continue;
+				}
+				void *addr = mmap(NULL,mappings[ix].length,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,ring,offsets[ix]);
+				if(addr == MAP_FAILED) {
+					throw system_error(errno,system_category(),"Cant map io_uring");
+				}
+				mappings[ix].addr = addr;
+			}
+
+			uint8_t *sqptr = (uint8_t *) mappings[0].addr;
+			uint8_t *cqptr = (uint8_t *) (mappings[1].addr ? mappings[1].addr : mappings[0].addr);
+
+			sq.head = (unsigned int *) (sqptr + params.sq_off.head);
+			sq.tail = (unsigned int *) (sqptr + params.sq_off.tail);
+			sq.mask = (unsigned int *) (sqptr + params.sq_off.ring_mask);
+			sq.array = (unsigned int *) (sqptr + params.sq_off.array);
+			sq.entries = params.sq_entries;
+			sq.sqes = (struct io_uring_sqe *) mappings[2].addr;
+
+			cq.head = (unsigned int *) (cqptr + params.cq_off.head);
+			cq.tail = (unsigned int *) (cqptr + params.cq_off.tail);
+			cq.mask = (unsigned int *) (cqptr + params.cq_off.ring_mask);
+			cq.cqes = (struct io_uring_cqe *) (cqptr + params.cq_off.cqes);
+			if(params.cq_off.flags) {
+				cq.flags = (unsigned int *) (cqptr + params.cq_off.flags);
+			}
+
+			// Completions are signaled on the main loop by an eventfd.
+			values.fd = eventfd(0,EFD_NONBLOCK|EFD_CLOEXEC);
+			if(values.fd < 0) {
+				throw system_error(errno,system_category(),"Cant create eventfd");
+			}
+
+			if(io_uring_register(ring,IORING_REGISTER_EVENTFD,&values.fd,1) < 0) {
+				throw system_error(errno,system_category(),"Cant register io_uring eventfd");
+			}
+
+			notify(false);
+
+			values.events = oninput;
+			enable();
+
+		} catch(...) {
+
+			for(Mapping &mapping : mappings) {
+				if(mapping.addr) {
+					munmap(mapping.addr,mapping.length);
+				}
+			}
+
+			if(values.fd >= 0) {
+				::close(values.fd);
+				values.fd = -1;
+			}
+
+			::close(ring);
+			throw;
+
+		}
+
+	}
+
+	URing::~URing() {
+
+		MainLoop::Handler::close();
+
+		for(Mapping &mapping : mappings) {
+			if(mapping.addr) {
+				munmap(mapping.addr,mapping.length);
+			}
+		}
+
+		::close(ring);
+
+	}
+
+	void URing::notify(bool enable) noexcept {
+#ifdef IORING_CQ_EVENTFD_DISABLED
+		if(cq.flags) {
+			unsigned int flags = __atomic_load_n(cq.flags,__ATOMIC_RELAXED);
+			if(enable) {
+				flags &= ~IORING_CQ_EVENTFD_DISABLED;
+			} else {
+				flags |= IORING_CQ_EVENTFD_DISABLED;
+			}
+			__atomic_store_n(cq.flags,flags,__ATOMIC_RELEASE);
+		}
+#endif // IORING_CQ_EVENTFD_DISABLED
+	}
+
+	unsigned int URing::space() const noexcept {
+		unsigned int head = __atomic_load_n(sq.head,__ATOMIC_ACQUIRE);
+		return sq.entries - ((*sq.tail + sq.queued) - head);
+	}
+
+	struct io_uring_sqe * URing::next(Request *request) noexcept {
+		unsigned int index = (*sq.tail + sq.queued) & *sq.mask;
+		struct io_uring_sqe *sqe = sq.sqes + index;
+		memset(sqe,0,sizeof(struct io_uring_sqe));
+		sqe->user_data = (uint64_t) request;
+		sq.array[index] = index;
+		sq.queued++;
+		return sqe;
+	}
+
+	struct io_uring_sqe * URing::get(Request *request) {
+
+		for(;;) {
+
+			if(space()) {
+				return next(request);
+			}
+
+			// Ring is full, submit the queued entries to release them.
+			submit();
+
+		}
+
+	}
+
+	unsigned int URing::publish() noexcept {
+		if(sq.queued) {
+			__atomic_store_n(sq.tail,*sq.tail + sq.queued,__ATOMIC_RELEASE);
+			sq.queued = 0;
+		}
+		return *sq.tail - __atomic_load_n(sq.head,__ATOMIC_ACQUIRE);
+	}
+
+	void URing::submit() {
+
+		std::vector<std::pair<Request *,int>> completed;
+
+		unsigned int pending;
+		while((pending = publish()) != 0) {
+
+			if(io_uring_enter(ring,pending,0,0) < 0) {
+
+				if(errno == EINTR) {
+					continue;
+				}
+
+				if(errno == EBUSY || errno == EAGAIN) {
+					// Completion backlog, release it and try again.
+					reap(completed);
+					continue;
+				}
+
+				throw system_error(errno,system_category(),"Cant submit io_uring requests");
+
+			}
+
+		}
+
+		deliver(completed,false);
+
+	}
+
+	void URing::reap(std::vector<std::pair<Request *,int>> &completed) {
+
+		unsigned int head = *cq.head;
+		unsigned int tail = __atomic_load_n(cq.tail,__ATOMIC_ACQUIRE);
+
+		if(head == tail) {
+			return;
+		}
+
+		while(head != tail) {
+
+			const struct io_uring_cqe *cqe = cq.cqes + (head & *cq.mask);
+			Request *request = (Request *) cqe->user_data;
+			int result = cqe->res;
+			head++;
+
+			if(request->async) {
+				completed.emplace_back(request,result);
+				if(!--async) {
+					notify(false);
+				}
+			} else {
+				// Batch request, just store the result.
+				request->call(result);
+				delete request;
+			}
+
+		}
+
+		__atomic_store_n(cq.head,head,__ATOMIC_RELEASE);
+		reaped.notify_all();
+
+	}
+
+	void URing::deliver(std::vector<std::pair<Request *,int>> &completed, bool mainloop) noexcept {
+
+		for(auto &it : completed) {
+
+			try {
+
+				if(mainloop) {
+					it.first->call(it.second);
+				} else {
+					MainLoop::getInstance().post(new Completion{it.first->call,it.second});
+				}
+
+			} catch(const std::exception &e) {
+
+				Logger::String{"Error on io_uring completion: ",e.what()}.error("file");
+
+			}
+
+			delete it.first;
+
+		}
+
+		completed.clear();
+
+	}
+
+	void URing::handle_event(const Event) {
+
+		uint64_t counter;
+		while(::read(values.fd,&counter,sizeof(counter)) > 0);
+
+		std::vector<std::pair<Request *,int>> completed;
+
+		{
+			lock_guard<mutex> lock(guard);
+
+			// A thread waiting on io_uring_enter() will reap, doing it here could leave it blocked.
+			if(waiting) {
+				return;
+			}
+
+			reap(completed);
+		}
+
+		deliver(completed,true);
+
+	}
+
+	void URing::prepare(struct io_uring_sqe *sqe, const Batch::Operation &operation, const char *path) noexcept {
+
+		sqe->opcode = operation.opcode;
+		sqe->fd = operation.fd;
+		sqe->addr = path ? (uint64_t) path : operation.addr;
+		sqe->len = operation.len;
+		sqe->off = operation.off;
+
+		switch(operation.opcode) {
+		case IORING_OP_OPENAT:
+			sqe->open_flags = operation.flags;
+			break;
+
+		case IORING_OP_FSYNC:
+			sqe->fsync_flags = operation.flags;
+			break;
+
+		case IORING_OP_STATX:
+			sqe->statx_flags = operation.flags;
+			break;
+
+		}
+
+	}
+
+	void URing::queue(const Batch::Operation &operation, const Callback &call) {
+
+		lock_guard<mutex> lock(guard);
+
+		Request *request = new Request{call,operation.path,true};
+
+		struct io_uring_sqe *sqe;
+		try {
+			sqe = get(request);
+		} catch(...) {
+			delete request;
+			throw;
+		}
+
+		prepare(sqe,operation,request->path.empty() ? nullptr : request->path.c_str());
+
+		if(!async++) {
+			notify(true);
+		}
+
+		submit();
+
+	}
+
+	void URing::read(int fd, void *buf, size_t length, uint64_t offset, const Callback &call) {
+		queue(Batch::Operation{IORING_OP_READ,fd,(uint64_t) buf,(uint32_t) length,offset,0,""},call);
+	}
+
+	void URing::write(int fd, const void *buf, size_t length, uint64_t offset, const Callback &call) {
+		queue(Batch::Operation{IORING_OP_WRITE,fd,(uint64_t) buf,(uint32_t) length,offset,0,""},call);
+	}
+
+	void URing::openat(int dirfd, const char *path, int flags, mode_t mode, const Callback &call) {
+		queue(Batch::Operation{IORING_OP_OPENAT,dirfd,0,(uint32_t) mode,0,(uint32_t) (flags|O_CLOEXEC),path},call);
+	}
+
+	void URing::fsync(int fd, bool datasync, const Callback &call) {
+		queue(Batch::Operation{IORING_OP_FSYNC,fd,0,0,0,(uint32_t) (datasync ? IORING_FSYNC_DATASYNC : 0),""},call);
+	}
+
+	void URing::statx(int dirfd, const char *path, int flags, unsigned int mask, struct statx *buf, const Callback &call) {
+		queue(Batch::Operation{IORING_OP_STATX,dirfd,0,mask,(uint64_t) buf,(uint32_t) flags,path},call);
+	}
+
+	void URing::Batch::read(int fd, void *buf, size_t length, uint64_t offset) {
+		operations.push_back(Operation{IORING_OP_READ,fd,(uint64_t) buf,(uint32_t) length,offset,0,""});
+	}
+
+	void URing::Batch::write(int fd, const void *buf, size_t length, uint64_t offset) {
+		operations.push_back(Operation{IORING_OP_WRITE,fd,(uint64_t) buf,(uint32_t) length,offset,0,""});
+	}
+
+	void URing::Batch::openat(int dirfd, const char *path, int flags, mode_t mode) {
+		operations.push_back(Operation{IORING_OP_OPENAT,dirfd,0,(uint32_t) mode,0,(uint32_t) (flags|O_CLOEXEC),path});
+	}
+
+	void URing::Batch::fsync(int fd, bool datasync) {
+		operations.push_back(Operation{IORING_OP_FSYNC,fd,0,0,0,(uint32_t) (datasync ? IORING_FSYNC_DATASYNC : 0),""});
+	}
+
+	void URing::Batch::statx(int dirfd, const char *path, int flags, unsigned int mask, struct statx *buf) {
+		operations.push_back(Operation{IORING_OP_STATX,dirfd,0,mask,(uint64_t) buf,(uint32_t) flags,path});
+	}
+
+	void URing::Batch::clear() noexcept {
+		operations.clear();
+		results.clear();
+		remaining = 0;
+	}
+
+	int URing::Batch::execute(const Operation &operation) noexcept {
+
+		long rc;
+
+		switch(operation.opcode) {
+		case IORING_OP_READ:
+			rc = pread(operation.fd,(void *) operation.addr,operation.len,operation.off);
+			break;
+
+		case IORING_OP_WRITE:
+			rc = pwrite(operation.fd,(const void *) operation.addr,operation.len,operation.off);
+			break;
+
+		case IORING_OP_OPENAT:
+			rc = ::openat(operation.fd,operation.path.c_str(),(int) operation.flags,(mode_t) operation.len);
+			break;
+
+		case IORING_OP_FSYNC:
+			rc = (operation.flags & IORING_FSYNC_DATASYNC) ? fdatasync(operation.fd) : ::fsync(operation.fd);
+			break;
+
+		case IORING_OP_STATX:
+			rc = ::statx(operation.fd,operation.path.c_str(),(int) operation.flags,operation.len,(struct statx *) operation.off);
+			break;
+
+		default:
+			return -EINVAL;
+		}
+
+		return rc < 0 ? -errno : (int) rc;
+
+	}
+
+	void URing::Batch::run() {
+
+		results.assign(operations.size(),-ECANCELED);
+		remaining = 0;
+
+		URing *uring = URing::getInstance();
+		if(!uring) {
+			// Not available (or disabled after a failure), use the plain syscalls.
+			for(size_t ix = 0; ix < operations.size(); ix++) {
+				results[ix] = execute(operations[ix]);
+			}
+			return;
+		}
+
+		// The whole slice must fit on the ring, it's only published after being prepared.
+		for(size_t from = 0; from < operations.size(); from += uring->sq.entries) {
+			run(*uring,from,std::min(operations.size(),from + uring->sq.entries));
+		}
+
+	}
+
+	void URing::Batch::run(URing &uring, size_t from, size_t to) {
+
+		/// @brief Result of an operation not yet completed.
+		static constexpr int inflight = INT_MIN;
+
+		/// @brief Give up after this number of io_uring_enter() failures without completions.
+		static constexpr unsigned int max_retries = 64;
+
+		// Allocate before touching the ring, a failure here leaves nothing queued.
+		std::vector<std::unique_ptr<Request>> requests;
+		requests.reserve(to-from);
+		for(size_t ix = from; ix < to; ix++) {
+			requests.emplace_back(new Request{[this,ix](int result){
+				results[ix] = result;
+				remaining--;
+			},operations[ix].path,false});
+		}
+
+		std::vector<std::pair<Request *,int>> completed;
+		unique_lock<mutex> lock(uring.guard);
+
+		if(uring.space() < requests.size()) {
+
+			// Release the SQEs queued by other threads first, nothing from this batch is on the ring yet.
+			uring.submit();
+
+			if(uring.space() < requests.size()) {
+
+				// Still busy, run this slice with the plain syscalls instead of failing the caller.
+				lock.unlock();
+				for(size_t ix = from; ix < to; ix++) {
+					results[ix] = execute(operations[ix]);
+				}
+				return;
+
+			}
+
+		}
+
+		// From now on nothing throws until the requests are completed, they reference this batch.
+		std::vector<unsigned int> positions;
+		positions.reserve(requests.size());
+
+		for(size_t ix = 0; ix < requests.size(); ix++) {
+			positions.push_back(*uring.sq.tail + uring.sq.queued);
+			Request *request = requests[ix].release();	// Owned by the ring until completed.
+			prepare(uring.next(request),operations[from+ix],request->path.empty() ? nullptr : request->path.c_str());
+			results[from+ix] = inflight;
+			remaining++;
+		}
+
+		unsigned int failures = 0;
+		int error = 0;
+
+		while(remaining) {
+
+			if(uring.waiting) {
+				// Another thread is waiting on the ring, it will reap our completions too.
+				try {
+					uring.submit();
+				} catch(const std::system_error &e) {
+					error = e.code().value();
+					break;
+				}
+				uring.reaped.wait(lock);
+				continue;
+			}
+
+			// Submit and wait with a single io_uring_enter(), the other threads will not reap
+			// while we are waiting, the completions are processed here when it returns.
+			uring.waiting = true;
+			unsigned int pending = uring.publish();
+			unsigned int wait = remaining;
+			lock.unlock();
+
+			int rc = io_uring_enter(uring.ring,pending,wait,IORING_ENTER_GETEVENTS);
+			error = errno;
+
+			lock.lock();
+			uring.waiting = false;
+
+			size_t before = remaining;
+			uring.reap(completed);
+			uring.reaped.notify_all();	// Wake the threads waiting for the ring, even without completions.
+
+			if(rc >= 0 || error == EINTR || remaining < before) {
+				failures = 0;
+				error = 0;
+				continue;
+			}
+
+			if((error == EBUSY || error == EAGAIN) && ++failures < max_retries) {
+				continue;
+			}
+
+			break;
+
+		}
+
+		if(remaining) {
+
+			// The ring is not working, stop using it.
+			Logger::String{"Error '",strerror(error),"' waiting for io_uring completions, disabling the engine"}.error("file");
+			uring.failed = true;
+
+			// Wait until nobody is on io_uring_enter(), the kernel could consume our SQEs.
+			uring.reaped.wait(lock,[&uring](){ return !uring.waiting; });
+
+			// The SQEs not consumed by the kernel become no-ops and run here, with the plain syscalls.
+			unsigned int head = __atomic_load_n(uring.sq.head,__ATOMIC_ACQUIRE);
+			for(size_t ix = 0; ix < positions.size(); ix++) {
+
+				if(results[from+ix] != inflight || (int) (positions[ix] - head) < 0) {
+					continue;
+				}
+
+				struct io_uring_sqe *sqe = uring.sq.sqes + (positions[ix] & *uring.sq.mask);
+				uint64_t user_data = sqe->user_data;
+				memset(sqe,0,sizeof(struct io_uring_sqe));
+				sqe->opcode = IORING_OP_NOP;
+				sqe->user_data = user_data;
+
+				// Detach from the batch, the request is released if the no-op ever completes.
+				((Request *) user_data)->call = [](int){};
+
+				results[from+ix] = execute(operations[from+ix]);
+				remaining--;
+
+			}
+
+			// The consumed ones are on the kernel and reference our buffers, wait for them without spinning.
+			while(remaining) {
+				uring.reaped.wait_for(lock,std::chrono::milliseconds(100));
+				uring.reap(completed);
+			}
+
+		}
+
+		lock.unlock();
+		deliver(completed,false);
+
+	}
+
+	uint64_t URing::copy(int from, uint64_t offset, int to, uint64_t destination, uint64_t length, size_t blksize, const std::function<bool(uint64_t copied)> &progress) {
+
+		std::vector<char> buffers[2] = { std::vector<char>(blksize), std::vector<char>(blksize) };
+
+		auto block = [length,blksize](uint64_t copied) -> size_t {
+			return (size_t) std::min((uint64_t) blksize, length - copied);
+		};
+
+		Batch batch;
+		batch.read(from,buffers[0].data(),block(0),offset);
+		batch.run();
+
+		uint64_t copied = 0;
+		size_t current = 0;
+		int received = batch[0];
+
+		while(received) {
+
+			if(received < 0) {
+				throw system_error(-received,system_category(),"Cant read from file");
+			}
+
+			// Write this block and read the next one with a single submission.
+			uint64_t next = copied + received;
+			bool more = (next < length);
+
+			batch.clear();
+			batch.write(to,buffers[current].data(),received,destination + copied);
+			if(more) {
+				batch.read(from,buffers[current^1].data(),block(next),offset + next);
+			}
+			batch.run();
+
+			int sent = batch[0];
+			if(sent < 0) {
+				throw system_error(-sent,system_category(),"Cant write to file");
+			}
+
+			while(sent < received) {
+				ssize_t bytes = pwrite(to,buffers[current].data() + sent,received - sent,destination + copied + sent);
+				if(bytes < 1) {
+					throw system_error(errno,system_category(),"Cant write to file");
+				}
+				sent += bytes;
+			}
+
+			copied = next;
+
+			if(progress && progress(copied)) {
+				throw system_error(ECANCELED,system_category());
+			}
+
+			if(!more) {
+				break;
+			}
+
+			received = batch[1];
+			current ^= 1;
+
+		}
+
+		return copied;
+
+	}
+
+ }
+
+#endif // HAVE_IO_URING
@@ -26,10 +26,17 @@
  #include <sys/inotify.h>
  #include <udjat/tools/logger.h>
  #include <udjat/tools/threadpool.h>
+ #include <udjat/tools/configuration.h>
  #include <udjat/tools/handler.h>
  #include <sys/types.h>
  #include <sys/stat.h>
+ #include <dirent.h>
+ #include <fcntl.h>
+ #include <algorithm>
+ #include <climits>
+ #include <cstdlib>
  #include <stdexcept>
+ #include <memory>
 
  #ifdef HAVE_UNISTD_H
 	#include <unistd.h>
@@ -38,15 +45,67 @@
  #define INOTIFY_EVENT_SIZE ( sizeof (inotify_event) )
  #define INOTIFY_EVENT_BUF_LEN ( 1024 * ( INOTIFY_EVENT_SIZE + 16 ) )
 
+ /// @brief Events for directory watchers.
+ #define DIRECTORY_MASK (IN_CREATE|IN_DELETE|IN_DELETE_SELF|IN_MOVE_SELF|IN_MOVED_TO)
+
+ /// @brief Events for file watchers.
+ #define FILE_MASK (IN_CLOSE_WRITE|IN_DELETE_SELF|IN_MOVE_SELF)
+
+ /// @brief Events for the directories of a recursive watcher.
+ #define TREE_MASK (DIRECTORY_MASK|IN_MOVED_FROM|IN_CLOSE_WRITE|IN_ONLYDIR|IN_DONT_FOLLOW)
+
  using namespace std;
 
  namespace Udjat {
 
+	/// @brief Get the canonical path for watcher.
+	static string canonical(const char *pathname) {
+		char path[PATH_MAX+1];
+		if(realpath(pathname,path)) {
+			return path;
+		}
+		return pathname;
+	}
+
+	/// @brief Append name to path.
+	static string join(const string &path, const char *name) {
+		string rc{path};
+		if(rc.empty() || rc.back() != '/') {
+			rc += '/';
+		}
+		rc += name;
+		return rc;
+	}
+
+	/// @brief Get the path of name on directory relative to the watcher root.
+	static string relative(const string &root, const string &path, const char *name) {
+		string rc;
+		if(path.size() > root.size()) {
+			rc.assign(path, root.size() + ((root.empty() || root.back() == '/') ? 0 : 1), string::npos);
+		}
+		if(name && *name) {
+			if(!rc.empty()) {
+				rc += '/';
+			}
+			rc += name;
+		}
+		return rc;
+	}
 
 	File::Watcher::Controller::Controller() {
 
 		Logger::String{"Starting service"}.trace("file-watcher");
 
+		debounce = Config::Value<unsigned int>("file-watcher","debounce",100).get();
+		max_watches = Config::Value<unsigned int>("file-watcher","max-watches",8192).get();
+		max_pending = Config::Value<unsigned int>("file-watcher","max-pending",4096).get();
+		max_scan = Config::Value<unsigned int>("file-watcher","max-scan",64).get();
+		if(!max_scan) {
+			max_scan = 1;
+		}
+
+		buffer.resize((INOTIFY_EVENT_BUF_LEN + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+
 		int fd = inotify_init1(IN_NONBLOCK|IN_CLOEXEC);
 		if(fd == -1) {
 			throw system_error(errno,system_category(),"Can't initialize inotify");
@@ -60,13 +119,15 @@
 	File::Watcher::Controller::~Controller() {
 
 		std::lock_guard<std::mutex> lock(guard);
-		handlers.remove_if([this](Handler &handler) {
-			if(handler.wd != -1) {
-				inotify_rm_watch(MainLoop::Handler::fd(), handler.wd);
-				handler.wd = -1;
-			}
-			return true;
-		});
+		for(auto &it : handlers) {
+			inotify_rm_watch(MainLoop::Handler::fd(), it.first);
+		}
+		handlers.clear();
+		paths.clear();
+		roots.clear();
+		scans.clear();
+		pending.clear();
+		last.clear();
 
 		MainLoop::Handler::disable();
 		::close(MainLoop::Handler::fd());
@@ -89,20 +150,40 @@
 
 		}
 
+		uint32_t mask;
+
 		if((st.st_mode & S_IFDIR)) {
 
+			if(watcher->recursive) {
+
+				// Directory tree watch.
+				string path{canonical(watcher->pathname)};
+				roots[watcher] = path;
+				try {
+					size_t budget = SIZE_MAX;
+					watch_tree(watcher,path,nullptr,budget);
+				} catch(...) {
+					roots.erase(watcher);
+					throw;
+				}
+
+				Logger::String{"Watching '",watcher->pathname,"' and its subdirectories"}.trace("file-watcher");
+				return;
+
+			}
+
 			// Directory watch
-			watch_directory(watcher);
+			mask = DIRECTORY_MASK;
 
 		} else if( (st.st_mode & S_IFREG)) {
 
 			// File watch.
-			watch_file(watcher);
+			mask = FILE_MASK;
 
 		} else if( (st.st_mode & S_IFLNK)) {
 
 			// Symbolic link
-			watch_file(watcher);
+			mask = FILE_MASK;
 
 		} else {
 
@@ -110,57 +191,188 @@
 
 		}
 
+		int wd = add_watch(canonical(watcher->pathname),mask);
+		if(wd == -1) {
+			throw runtime_error(Logger::String{"Can't watch '",watcher->pathname,"', the watch limit was reached"});
+		}
+
+		Handler &handler = handlers[wd];
+		handler.mask |= mask;
+		handler.files.push_back(watcher);
+
 		Logger::String{"Watching '",watcher->pathname,"'"}.trace("file-watcher");
 
 	}
 
-	void File::Watcher::Controller::watch_file(File::Watcher *watcher) {
+	int File::Watcher::Controller::add_watch(const std::string &path, uint32_t mask) {
 
-		// Is this path being watched?
-		for(Handler &handler : handlers) {
-			for(File::Watcher *file : handler.files) {
-				if(!strcmp(file->pathname,watcher->pathname)) {
-					handler.files.push_back(watcher);
-					return;
-				}
-			}
+		if(!paths.count(path) && handlers.size() >= max_watches) {
+			return -1;
 		}
 
-		// Add a new handler.
-		Handler handler;
-		handler.files.push_back(watcher);
+		// IN_MASK_ADD keeps the events requested by the other watchers of the same inode.
+		int wd = inotify_add_watch(MainLoop::Handler::fd(),path.c_str(),mask|IN_MASK_ADD);
+		if(wd == -1) {
+			throw system_error(errno,system_category(),string{"Can't add watch for '"} + path + "'");
+		}
 
-		handler.wd = inotify_add_watch(MainLoop::Handler::fd(),watcher->pathname,IN_CLOSE_WRITE|IN_DELETE_SELF|IN_MOVE_SELF);
+		// The kernel returns the same descriptor for another path to the same inode.
+		Handler &handler = handlers[wd];
 		if(handler.wd == -1) {
-			throw system_error(errno,system_category(),string{"Can't add watch for '"} + watcher->pathname + "'");
+			handler.wd = wd;
+			handler.path = path;
 		}
+		paths[path] = wd;
 
-		handlers.push_back(handler);
+		return wd;
 
 	}
 
-	void File::Watcher::Controller::watch_directory(File::Watcher *watcher) {
+	void File::Watcher::Controller::watch_tree(File::Watcher *watcher, const std::string &path, std::vector<std::string> *found, size_t &budget) {
+
+		auto entry = roots.find(watcher);
+		if(entry == roots.end()) {
+			return;
+		}
+
+		// Copy, the roots can change while scanning.
+		const string root{entry->second};
+		bool warned = false;
+
+		std::vector<string> directories{path};
+		while(!directories.empty()) {
+
+			if(!budget) {
+				// Enough for this pass, leave the others for the next one.
+				for(string &directory : directories) {
+					scans.push_back(Scan{watcher,std::move(directory),found != nullptr});
+				}
+				return;
+			}
+			budget--;
+
+			string directory{std::move(directories.back())};
+			directories.pop_back();
+
+			int wd;
+			try {
 
-		// Is this path being watched?
-		for(Handler &handler : handlers) {
-			for(File::Watcher *file : handler.files) {
-				if(!strcmp(file->pathname,watcher->pathname)) {
-					handler.files.push_back(watcher);
-					return;
+				wd = add_watch(directory,TREE_MASK);
+
+			} catch(const std::exception &e) {
+
+				if(directory == root) {
+					throw;
 				}
+				Logger::String{e.what()}.warning("file-watcher");
+				continue;
+
+			}
+
+			if(wd == -1) {
+				if(!warned) {
+					Logger::String{"Watch limit reached, ignoring '",directory,"' and other subdirectories of '",root,"'"}.warning("file-watcher");
+					warned = true;
+				}
+				continue;
+			}
+
+			Handler &handler = handlers[wd];
+			if(find(handler.trees.begin(),handler.trees.end(),watcher) == handler.trees.end()) {
+				handler.trees.push_back(watcher);
+			}
+
+			if(handler.path != directory) {
+				// Another path to a watched directory (bind mount), don't loop.
+				continue;
 			}
+
+			DIR *dir = opendir(directory.c_str());
+			if(!dir) {
+				continue;
+			}
+
+			struct dirent *entry;
+			while((entry = readdir(dir)) != NULL) {
+
+				if(entry->d_name[0] == '.' && (!entry->d_name[1] || (entry->d_name[1] == '.' && !entry->d_name[2]))) {
+					continue;
+				}
+
+				bool isdir = (entry->d_type == DT_DIR);
+				if(entry->d_type == DT_UNKNOWN) {
+					struct stat st;
+					isdir = (fstatat(dirfd(dir),entry->d_name,&st,AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode));
+				}
+
+				string child{join(directory,entry->d_name)};
+
+				if(found) {
+					found->push_back(relative(root,child,nullptr));
+				}
+
+				if(isdir) {
+					directories.push_back(std::move(child));
+				}
+
+			}
+
+			closedir(dir);
+
 		}
 
-		// Add a new handler.
-		Handler handler;
-		handler.files.push_back(watcher);
+	}
 
-		handler.wd = inotify_add_watch(MainLoop::Handler::fd(),watcher->pathname,IN_CREATE|IN_DELETE|IN_DELETE_SELF|IN_MOVE_SELF|IN_MOVED_TO);
-		if(handler.wd == -1) {
-			throw system_error(errno,system_category(),string{"Can't add watch for '"} + watcher->pathname + "'");
+	void File::Watcher::Controller::unwatch_tree(File::Watcher *watcher, const std::string &path) noexcept {
+
+		string prefix{join(path,"")};
+
+		scans.erase(std::remove_if(scans.begin(),scans.end(),[watcher,&path,&prefix](const Scan &scan){
+			return scan.watcher == watcher && (scan.path == path || scan.path.compare(0,prefix.size(),prefix) == 0);
+		}),scans.end());
+
+		std::vector<int> unused;
+		for(auto &it : handlers) {
+
+			const string &name = it.second.path;
+			if(name != path && name.compare(0,prefix.size(),prefix) != 0) {
+				continue;
+			}
+
+			it.second.trees.remove(watcher);
+			if(it.second.files.empty() && it.second.trees.empty()) {
+				unused.push_back(it.first);
+			}
+
+		}
+
+		for(int wd : unused) {
+			release(wd);
+		}
+
+	}
+
+	void File::Watcher::Controller::release(int wd) noexcept {
+		inotify_rm_watch(MainLoop::Handler::fd(), wd);
+		remove_watch(wd);
+	}
+
+	void File::Watcher::Controller::remove_watch(int wd) noexcept {
+
+		auto it = handlers.find(wd);
+		if(it == handlers.end()) {
+			return;
+		}
+
+		for(auto path = paths.begin(); path != paths.end();) {
+			if(path->second == wd) {
+				path = paths.erase(path);
+			} else {
+				path++;
+			}
 		}
 
-		handlers.push_back(handler);
+		handlers.erase(it);
 
 	}
 
@@ -168,127 +380,375 @@
 
 		std::lock_guard<std::mutex> lock(guard);
 
-		handlers.remove_if([this,watcher](Handler &handler) {
+		roots.erase(watcher);
 
-			handler.files.remove_if([watcher](File::Watcher *f) {
-				return f == watcher;
-			});
+		scans.erase(std::remove_if(scans.begin(),scans.end(),[watcher](const Scan &scan){
+			return scan.watcher == watcher;
+		}),scans.end());
+
+		std::vector<int> empty;
+		for(auto &it : handlers) {
+
+			it.second.files.remove(watcher);
+			it.second.trees.remove(watcher);
 
 			// Remove handler if empty.
-			if(handler.files.empty() && handler.wd != -1) {
-				inotify_rm_watch(MainLoop::Handler::fd(), handler.wd);
-				handler.wd = -1;
+			if(it.second.files.empty() && it.second.trees.empty()) {
+				empty.push_back(it.first);
+			}
+
+		}
+
+		for(int wd : empty) {
+			release(wd);
+		}
+
+	}
+
+	void File::Watcher::Controller::rescan() noexcept {
+
+		// Forget the directories removed while the events were lost.
+		std::vector<int> unused;
+		for(auto &it : handlers) {
+
+			if(it.second.trees.empty()) {
+				continue;
+			}
+
+			struct stat st;
+			if(lstat(it.second.path.c_str(),&st) == 0 && S_ISDIR(st.st_mode)) {
+				continue;
+			}
+
+			it.second.trees.clear();
+			if(it.second.files.empty()) {
+				unused.push_back(it.first);
 			}
-			return handler.wd == -1;
-		});
+
+		}
+
+		for(int wd : unused) {
+			release(wd);
+		}
+
+		// Watch the new ones, on the next passes.
+		for(auto &it : roots) {
+			scans.push_back(Scan{it.first,it.second,false});
+		}
 
 	}
 
 	void File::Watcher::Controller::onEvent(const ::inotify_event *event) noexcept {
 
-		std::lock_guard<std::mutex> lock(guard);
+		if(event->wd == -1) {
+			if(event->mask & IN_Q_OVERFLOW) {
+				Logger::String{"The inotify queue has overflowed, rescanning"}.warning("file-watcher");
+				overflow = true;
+			}
+			return;
+		}
+
+		if(!handlers.count(event->wd)) {
+			return;
+		}
+
+		if(pending.size() >= max_pending) {
+			// Too many events, drop them and resync the watchers.
+			overflow = true;
+			return;
+		}
+
+		try {
+
+			// Coalesce repeated events for the same file.
+			string key{std::to_string(event->wd)};
+			key += '/';
+			if(event->len) {
+				key += event->name;
+			}
+
+			auto it = last.find(key);
+			if(it != last.end() && pending[it->second].mask == event->mask) {
+				return;
+			}
 
-		auto mask = event->mask;
-		auto filename = make_shared<string>(event->name);
+			last[key] = pending.size();
+			pending.push_back(Pending{event->wd,event->mask,(event->len ? event->name : "")});
+
+		} catch(const std::exception &e) {
+
+			Logger::String{"Error queueing event: ",e.what()}.error("file-watcher");
+
+		}
+
+	}
+
+	void File::Watcher::Controller::dispatch() noexcept {
+
+		/// @brief Events for a single watcher.
+		struct Batch {
+			File::Watcher *file;
+			std::vector<std::pair<uint32_t,string>> events;
+		};
+
+		std::vector<Batch> batches;
+
+		auto enqueue = [&batches](File::Watcher *file, uint32_t mask, const string &name) {
+
+			auto batch = batches.begin();
+			while(batch != batches.end() && batch->file != file) {
+				batch++;
+			}
+
+			if(batch == batches.end()) {
+				batches.push_back(Batch{file,{}});
+				batch = batches.end()-1;
+			}
 
-		for(auto &handler : handlers) {
+			batch->events.emplace_back(mask,name);
 
-			if(handler.wd == event->wd) {
+		};
 
-				if(mask & IN_IGNORED) {
-					handler.wd = -1;
+		size_t budget = max_scan;
+
+		{
+			std::lock_guard<std::mutex> lock(guard);
+
+			// Continue the scans left by the previous passes.
+			while(budget && !scans.empty()) {
+
+				Scan scan{std::move(scans.front())};
+				scans.erase(scans.begin());
+
+				if(!roots.count(scan.watcher)) {
+					continue;
 				}
 
-				for(auto file : handler.files) {
+				std::vector<string> found;
+				try {
+					watch_tree(scan.watcher,scan.path,scan.report ? &found : nullptr,budget);
+				} catch(const std::exception &e) {
+					Logger::String{"Error scanning '",scan.path,"': ",e.what()}.error("file-watcher");
+				}
 
-					ThreadPool::getInstance().push("FileWatcherEvent",[mask,file,filename](){
+				for(const string &name : found) {
+					enqueue(scan.watcher,IN_CREATE,name);
+				}
 
-						const char *name = filename->empty() ? file->pathname : filename->c_str();
+			}
 
-						debug("Event on '",name,"'");
+			if(overflow) {
 
-						sched_yield();
-						sched_yield();
-						sched_yield();
+				// Events were lost, resync and notify every watcher.
+				overflow = false;
+				rescan();
 
-						try {
+				for(auto &it : handlers) {
+					for(auto file : it.second.files) {
+						enqueue(file,IN_Q_OVERFLOW,"");
+					}
+				}
 
-							if(mask & IN_CLOSE_WRITE) {
-								Logger::String{"File '",name,"' was changed"}.trace("file-watcher");
-								file->updated(Modified,name);
-							}
+				for(auto &it : roots) {
+					enqueue(it.first,IN_Q_OVERFLOW,"");
+				}
 
-							if(mask & (IN_DELETE_SELF|IN_DELETE)) {
-								Logger::String{"File '",name,"' was deleted"}.trace("file-watcher");
-								file->updated(Deleted,name);
-							}
+			}
 
-							if(mask & IN_MOVE_SELF) {
-								Logger::String{"File '",name,"' was moved"}.trace("file-watcher");
-								file->updated(MovedFrom,name);
-							}
+			for(const Pending &event : pending) {
+
+				auto it = handlers.find(event.wd);
+				if(it == handlers.end()) {
+					continue;
+				}
+
+				Handler &handler = it->second;
+
+				uint32_t mask = event.mask & handler.mask;
+				if(mask) {
+					for(auto file : handler.files) {
+						enqueue(file,mask,event.name);
+					}
+				}
+
+				if(!handler.trees.empty()) {
 
-							if(mask & IN_CREATE) {
-								Logger::String{"File '",name,"' was created on '",file->pathname,"'"}.trace("file-watcher");
-								file->updated(Created,name);
+					// Copy, watch_tree and unwatch_tree can change the list.
+					std::list<File::Watcher *> trees{handler.trees};
+					string path{handler.path};
+
+					for(auto file : trees) {
+
+						// Copy, watch_tree and unwatch_tree can change the roots.
+						auto entry = roots.find(file);
+						if(entry == roots.end()) {
+							continue;
+						}
+						const string root{entry->second};
+
+						mask = event.mask;
+						if(path != root) {
+							// Reported by the parent directory.
+							mask &= ~(IN_DELETE_SELF|IN_MOVE_SELF);
+						}
+
+						if(mask & (DIRECTORY_MASK|IN_MOVED_FROM|IN_CLOSE_WRITE)) {
+							enqueue(file,mask,relative(root,path,event.name.c_str()));
+						}
+
+						if(!(event.mask & IN_ISDIR) || event.name.empty()) {
+							continue;
+						}
+
+						string child{join(path,event.name.c_str())};
+
+						if(event.mask & (IN_CREATE|IN_MOVED_TO)) {
+
+							// New subdirectory, watch it and report the entries created before the watch.
+							std::vector<string> found;
+							try {
+								watch_tree(file,child,&found,budget);
+							} catch(const std::exception &e) {
+								Logger::String{e.what()}.error("file-watcher");
 							}
 
-							if(mask & IN_MOVED_TO) {
-								Logger::String{"File '",name,"' was moved to '",file->pathname,"'"}.trace("file-watcher");
-								file->updated(MovedTo,name);
+							for(const string &name : found) {
+								enqueue(file,IN_CREATE,name);
 							}
 
-						} catch(const std::exception &e) {
+						} else if(event.mask & (IN_DELETE|IN_MOVED_FROM)) {
 
-							Logger::String{"File '",name,"': ",e.what()}.error("file-watcher");
+							unwatch_tree(file,child);
 
 						}
 
-					});
+					}
+
+				}
+
+				if(event.mask & IN_IGNORED) {
+					// The watch was removed by the kernel.
+					remove_watch(event.wd);
 				}
 
-				return;
+			}
+
+			pending.clear();
+			last.clear();
+
+			if(!scans.empty() && !MainLoop::Timer::enabled()) {
+				// Directories left to scan, continue after the other main loop events.
+				MainLoop::Timer::enable(debounce ? debounce : 1);
 			}
 
 		}
 
-	}
+		for(auto &batch : batches) {
 
-	void File::Watcher::Controller::handle_event(const MainLoop::Handler::Event) {
+			auto events = make_shared<Batch>(std::move(batch));
 
-		char * buffer = new char[INOTIFY_EVENT_BUF_LEN];
-		memset(buffer,0,INOTIFY_EVENT_BUF_LEN);
+			ThreadPool::getInstance().push("FileWatcherEvent",[events](){
 
-		ssize_t bytes = read(buffer, INOTIFY_EVENT_BUF_LEN);
+				File::Watcher *file = events->file;
 
-		while(bytes > 0) {
+				for(const auto &event : events->events) {
 
-			ssize_t	bufPtr	= 0;
+					auto mask = event.first;
+					const char *name = event.second.empty() ? file->pathname : event.second.c_str();
 
-			while(bufPtr < bytes) {
-				const ::inotify_event *pevent = (::inotify_event *) &buffer[bufPtr];
-				onEvent(pevent);
-				bufPtr += (offsetof (::inotify_event, name) + pevent->len);
-			}
+					debug("Event on '",name,"'");
+
+					try {
+
+						if(mask & IN_Q_OVERFLOW) {
+							Logger::String{"Events on '",name,"' were lost"}.trace("file-watcher");
+							file->updated(Modified,name);
+						}
+
+						if(mask & IN_CLOSE_WRITE) {
+							Logger::String{"File '",name,"' was changed"}.trace("file-watcher");
+							file->updated(Modified,name);
+						}
+
+						if(mask & (IN_DELETE_SELF|IN_DELETE)) {
+							Logger::String{"File '",name,"' was deleted"}.trace("file-watcher");
+							file->updated(Deleted,name);
+						}
+
+						if(mask & IN_MOVE_SELF) {
+							Logger::String{"File '",name,"' was moved"}.trace("file-watcher");
+							file->updated(MovedFrom,name);
+						}
+
+						if(mask & IN_MOVED_FROM) {
+							Logger::String{"File '",name,"' was moved from '",file->pathname,"'"}.trace("file-watcher");
+							file->updated(MovedFrom,name);
+						}
+
+						if(mask & IN_CREATE) {
+							Logger::String{"File '",name,"' was created on '",file->pathname,"'"}.trace("file-watcher");
+							file->updated(Created,name);
+						}
+
+						if(mask & IN_MOVED_TO) {
+							Logger::String{"File '",name,"' was moved to '",file->pathname,"'"}.trace("file-watcher");
+							file->updated(MovedTo,name);
+						}
+
+					} catch(const std::exception &e) {
+
+						Logger::String{"File '",name,"': ",e.what()}.error("file-watcher");
+
+					}
+
+				}
+
+			});
 
-			bytes = read(buffer, INOTIFY_EVENT_BUF_LEN);
 		}
 
-		delete[] buffer;
+	}
+
+	void File::Watcher::Controller::on_timer() {
+		MainLoop::Timer::disable();
+		dispatch();
+	}
+
+	void File::Watcher::Controller::handle_event(const MainLoop::Handler::Event) {
 
-		// Cleanup
 		{
 			std::lock_guard<std::mutex> lock(guard);
-			handlers.remove_if([this](Handler &handler) {
-				if(handler.files.empty() && handler.wd != -1) {
-					inotify_rm_watch(MainLoop::Handler::fd(), handler.wd);
-					handler.wd = -1;
+
+			char *events = (char *) buffer.data();
+
+			// Drain the inotify buffer.
+			ssize_t bytes = read(events, INOTIFY_EVENT_BUF_LEN);
+			while(bytes > 0) {
+
+				ssize_t	bufPtr	= 0;
+
+				while(bufPtr < bytes) {
+					const ::inotify_event *pevent = (::inotify_event *) &events[bufPtr];
+					onEvent(pevent);
+					bufPtr += (offsetof (::inotify_event, name) + pevent->len);
 				}
-				return handler.wd == -1;
-			});
+
+				bytes = read(events, INOTIFY_EVENT_BUF_LEN);
+			}
+
+			if(pending.empty() && !overflow) {
+				return;
+			}
+
+		}
+
+		if(!debounce) {
+			dispatch();
+		} else if(!MainLoop::Timer::enabled()) {
+			// Wait for the burst to finish.
+			MainLoop::Timer::enable(debounce);
 		}
 
 	}
 
  }
-
@@ -58,58 +58,52 @@
 
 	bool IP::for_each(const std::function<bool(const IP::Addresses &addr)> &func) {
 
-		return for_each([&func](const ifaddrs &intf){
+		auto tables = Netlink::Monitor::getInstance().get();
 
-			IP::Addresses addr;
-
-			addr.interface_name = intf.ifa_name;
-			addr.address = intf.ifa_addr;
-			addr.netmask = intf.ifa_netmask;
+		for(const Netlink::Address &address : tables->addresses) {
 
-			return func(addr);
-
-		});
+			const Netlink::Link *link = tables->find(address.index);
+			if(!link) {
+				continue;
+			}
 
-	}
+			IP::Addresses addr;
 
-	UDJAT_API IP::Address IP::gateway() {
+			addr.interface_name = link->name.c_str();
+			addr.address = address.address;
+			addr.netmask = address.netmask;
 
-		struct sockaddr_in gateway;
-		memset(&gateway,0,sizeof(gateway));
+			if(func(addr)) {
+				return true;
+			}
 
-		if(!netlink_routes([&](const struct nlmsghdr *nlh) -> bool {
+		}
 
-			struct rtmsg *route_entry = (struct rtmsg *) NLMSG_DATA(nlh);
+		return false;
 
-			// We are just interested in main routing table
-			if (route_entry->rtm_table != RT_TABLE_MAIN) {
-				return false;
-			}	
+	}
 
-			struct rtattr *route_attribute = (struct rtattr *) RTM_RTA(route_entry);
-			size_t route_attribute_len = RTM_PAYLOAD(nlh);
+	UDJAT_API IP::Address IP::gateway() {
 
-			for(;RTA_OK(route_attribute, route_attribute_len); route_attribute = RTA_NEXT(route_attribute, route_attribute_len)) {
-				if(route_attribute->rta_type == RTA_GATEWAY) {
+		auto tables = Netlink::Monitor::getInstance().get();
 
-					if((unsigned) route_attribute_len > sizeof(struct sockaddr_in)) {
-						throw runtime_error(_("Invalid size on RTA_GATEWAY"));
-					}
+		for(int family : { AF_INET, AF_INET6 }) {
 
-					gateway.sin_family = AF_INET;
-					memcpy(&gateway.sin_addr,RTA_DATA(route_attribute),sizeof(gateway.sin_addr));
+			const Netlink::Route *route = tables->route(family);
+			if(route && route->gateway.ss_family != AF_UNSPEC) {
+				return IP::Address{route->gateway};
+			}
 
-					return true;
+		}
 
-				}
+		// No default route with gateway, get the first one on the main table.
+		for(const Netlink::Route &route : tables->routes) {
+			if(route.table == RT_TABLE_MAIN && route.gateway.ss_family != AF_UNSPEC) {
+				return IP::Address{route.gateway};
 			}
-			
-			return false;
-		})) {
-			throw runtime_error("Unable to find default gateway");
 		}
 
-		return IP::Address{&gateway};
+		throw runtime_error("Unable to find default gateway");
 
 	}
 
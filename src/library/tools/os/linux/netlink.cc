@@ -0,0 +1,819 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+ /**
+  * @brief Implements the netlink monitor keeping the kernel link, address and route tables.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <private/linux/netlink.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/intl.h>
+ #include <linux/netlink.h>
+ #include <linux/rtnetlink.h>
+ #include <linux/if_link.h>
+ #include <net/if.h>
+ #include <netinet/in.h>
+ #include <sys/poll.h>
+ #include <sys/time.h>
+ #include <cstring>
+ #include <algorithm>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Size of the socket receive buffer, large enough to hold the bursts of notifications.
+	static const int RCVBUF_SIZE = 1024 * 1024;
+
+	/// @brief Store address on sockaddr_storage.
+	static void store(sockaddr_storage &storage, uint8_t family, const void *data, size_t length) {
+
+		memset(&storage,0,sizeof(storage));
+
+		switch(family) {
+		case AF_INET:
+			if(length >= sizeof(in_addr)) {
+				storage.ss_family = AF_INET;
+				memcpy(&((sockaddr_in *) &storage)->sin_addr,data,sizeof(in_addr));
+			}
+			break;
+
+		case AF_INET6:
+			if(length >= sizeof(in6_addr)) {
+				storage.ss_family = AF_INET6;
+				memcpy(&((sockaddr_in6 *) &storage)->sin6_addr,data,sizeof(in6_addr));
+			}
+			break;
+
+		}
+
+	}
+
+	/// @brief Build netmask from prefix length.
+	static void netmask(sockaddr_storage &storage, uint8_t family, uint8_t prefix) {
+
+		uint8_t mask[sizeof(in6_addr)];
+		memset(mask,0,sizeof(mask));
+
+		for(size_t ix = 0; ix < sizeof(mask) && prefix; ix++) {
+			uint8_t bits = std::min(prefix,(uint8_t) 8);
+			mask[ix] = (uint8_t) (0xff00 >> bits);
+			prefix -= bits;
+		}
+
+		store(storage,family,mask,sizeof(mask));
+
+	}
+
+	static bool operator==(const sockaddr_storage &a, const sockaddr_storage &b) noexcept {
+		return memcmp(&a,&b,sizeof(sockaddr_storage)) == 0;
+	}
+
+	/// @brief Call method on every attribute of a netlink message.
+	static void for_each(const struct rtattr *rta, size_t length, const std::function<void(const struct rtattr *rta)> &call) {
+		for(;RTA_OK(rta,length);rta = RTA_NEXT(rta,length)) {
+			call(rta);
+		}
+	}
+
+	/// @brief Update vector item.
+	/// @param items The vector to update.
+	/// @param item The new value.
+	/// @param remove true to remove the item.
+	/// @param same Method to identify the item.
+	/// @return true if the vector was changed.
+	template <typename T>
+	static bool update(std::vector<T> &items, const T &item, bool remove, const std::function<bool(const T &a, const T &b)> &same) {
+
+		auto it = std::find_if(items.begin(),items.end(),[&](const T &entry){
+			return same(entry,item);
+		});
+
+		if(remove) {
+			if(it == items.end()) {
+				return false;
+			}
+			items.erase(it);
+			return true;
+		}
+
+		if(it == items.end()) {
+			items.push_back(item);
+		} else {
+			*it = item;
+		}
+
+		return true;
+
+	}
+
+	bool Netlink::Link::set(const struct nlmsghdr *msg) {
+
+		if((msg->nlmsg_type != RTM_NEWLINK && msg->nlmsg_type != RTM_DELLINK) || msg->nlmsg_len < NLMSG_LENGTH(sizeof(struct ifinfomsg))) {
+			return false;
+		}
+
+		const struct ifinfomsg *ifi = (const struct ifinfomsg *) NLMSG_DATA(msg);
+
+		index = ifi->ifi_index;
+		flags = ifi->ifi_flags;
+
+		for_each(IFLA_RTA(ifi),IFLA_PAYLOAD(msg),[this](const struct rtattr *rta){
+
+			switch(rta->rta_type) {
+			case IFLA_IFNAME:
+				name.assign((const char *) RTA_DATA(rta),strnlen((const char *) RTA_DATA(rta),RTA_PAYLOAD(rta)));
+				break;
+
+			case IFLA_MTU:
+				if(RTA_PAYLOAD(rta) >= sizeof(uint32_t)) {
+					memcpy(&mtu,RTA_DATA(rta),sizeof(uint32_t));
+				}
+				break;
+
+			case IFLA_OPERSTATE:
+				if(RTA_PAYLOAD(rta) >= sizeof(uint8_t)) {
+					operstate = *((const uint8_t *) RTA_DATA(rta));
+				}
+				break;
+
+			case IFLA_ADDRESS:
+				{
+					static const char *digits = "0123456789ABCDEF";
+					const uint8_t *data = (const uint8_t *) RTA_DATA(rta);
+					macaddress.clear();
+					for(size_t ix = 0; ix < RTA_PAYLOAD(rta); ix++) {
+						macaddress += digits[(data[ix] >> 4) & 0x0f];
+						macaddress += digits[data[ix] & 0x0f];
+					}
+				}
+				break;
+
+			case IFLA_STATS64:
+				if(RTA_PAYLOAD(rta) >= sizeof(struct rtnl_link_stats64)) {
+					struct rtnl_link_stats64 values;
+					memcpy(&values,RTA_DATA(rta),sizeof(values));
+					stats.rx_packets = values.rx_packets;
+					stats.tx_packets = values.tx_packets;
+					stats.rx_bytes = values.rx_bytes;
+					stats.tx_bytes = values.tx_bytes;
+					stats.rx_errors = values.rx_errors;
+					stats.tx_errors = values.tx_errors;
+					stats.rx_dropped = values.rx_dropped;
+					stats.tx_dropped = values.tx_dropped;
+				}
+				break;
+
+			}
+
+		});
+
+		return true;
+
+	}
+
+	const char * Netlink::Link::state() const noexcept {
+
+		// RFC 2863 states, in IF_OPER_* order.
+		static const char *names[] = {
+			"unknown",
+			"notpresent",
+			"down",
+			"lowerlayerdown",
+			"testing",
+			"dormant",
+			"up"
+		};
+
+		if(operstate < (sizeof(names)/sizeof(names[0]))) {
+			return names[operstate];
+		}
+
+		return names[0];
+
+	}
+
+	bool Netlink::Link::parse(std::vector<Link> &links, const void *buffer, size_t length) {
+
+		for(const struct nlmsghdr *msg = (const struct nlmsghdr *) buffer; NLMSG_OK(msg,length); msg = NLMSG_NEXT(msg,length)) {
+
+			if(msg->nlmsg_type == NLMSG_DONE) {
+				return true;
+			}
+
+			if(msg->nlmsg_type == NLMSG_ERROR) {
+				if(msg->nlmsg_len >= NLMSG_LENGTH(sizeof(struct nlmsgerr))) {
+					const struct nlmsgerr *err = (const struct nlmsgerr *) NLMSG_DATA(msg);
+					if(err->error) {
+						throw system_error(-err->error,system_category(),_("Netlink request has failed"));
+					}
+				}
+				return true;
+			}
+
+			Link link;
+			if(link.set(msg)) {
+				links.push_back(std::move(link));
+			}
+
+			if(!(msg->nlmsg_flags & NLM_F_MULTI)) {
+				return true;
+			}
+
+		}
+
+		return false;
+
+	}
+
+	std::vector<Netlink::Link> Netlink::Link::snapshot(int index) {
+
+		std::vector<Link> links;
+
+		Socket sock{AF_NETLINK, SOCK_RAW|SOCK_CLOEXEC, NETLINK_ROUTE};
+
+		// 1 Sec Timeout to avoid stall
+		{
+			struct timeval tv;
+			memset(&tv,0,sizeof(tv));
+			tv.tv_sec = 1;
+			setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, (struct timeval *)&tv, sizeof(struct timeval));
+		}
+
+		struct {
+			struct nlmsghdr header;
+			struct ifinfomsg ifi;
+		} request;
+
+		memset(&request,0,sizeof(request));
+		request.header.nlmsg_len = NLMSG_LENGTH(sizeof(request.ifi));
+		request.header.nlmsg_type = RTM_GETLINK;
+		request.header.nlmsg_flags = NLM_F_REQUEST | (index ? 0 : NLM_F_DUMP);
+		request.header.nlmsg_seq = 1;
+		request.ifi.ifi_family = AF_UNSPEC;
+		request.ifi.ifi_index = index;
+
+		if(send(sock,&request,request.header.nlmsg_len,0) < 0) {
+			throw system_error(errno,system_category(),_("Cant send netlink message"));
+		}
+
+		std::vector<char> buffer(32768);
+		bool done = false;
+
+		while(!done) {
+
+			ssize_t length = recv(sock,buffer.data(),buffer.size(),0);
+			if(length < 0) {
+				if(errno == EINTR) {
+					continue;
+				}
+				throw system_error(errno,system_category(),_("Cant receive netlink response"));
+			}
+
+			done = (length == 0 || parse(links,buffer.data(),length));
+
+		}
+
+		return links;
+
+	}
+
+	const Netlink::Link * Netlink::Monitor::Tables::find(int index) const noexcept {
+		for(const Link &link : links) {
+			if(link.index == index) {
+				return &link;
+			}
+		}
+		return nullptr;
+	}
+
+	const Netlink::Link * Netlink::Monitor::Tables::find(const char *name) const noexcept {
+		for(const Link &link : links) {
+			if(link.name == name) {
+				return &link;
+			}
+		}
+		return nullptr;
+	}
+
+	const Netlink::Route * Netlink::Monitor::Tables::route(int family) const noexcept {
+		const Route *selected = nullptr;
+		for(const Route &route : routes) {
+			if(route.family == family && route.length == 0 && route.table == RT_TABLE_MAIN && (!selected || route.priority < selected->priority)) {
+				selected = &route;
+			}
+		}
+		return selected;
+	}
+
+	Netlink::Monitor & Netlink::Monitor::getInstance() {
+		static Monitor instance;
+		return instance;
+	}
+
+	Netlink::Monitor::Monitor(int fd) : tables{make_shared<Tables>()}, buffer(32768) {
+		values.fd = fd;
+		values.events = oninput;
+		enable();
+	}
+
+	Netlink::Monitor::Monitor() : tables{make_shared<Tables>()}, buffer(32768) {
+
+		int fd = socket(AF_NETLINK, SOCK_RAW|SOCK_NONBLOCK|SOCK_CLOEXEC, NETLINK_ROUTE);
+		if(fd < 0) {
+			throw system_error(errno,system_category(),_("Cant get netlink socket"));
+		}
+
+		// Not fatal, the tables are reloaded if the kernel drops notifications.
+		setsockopt(fd,SOL_SOCKET,SO_RCVBUF,&RCVBUF_SIZE,sizeof(RCVBUF_SIZE));
+
+		struct sockaddr_nl addr;
+		memset(&addr,0,sizeof(addr));
+		addr.nl_family = AF_NETLINK;
+		addr.nl_groups = RTMGRP_LINK|RTMGRP_IPV4_IFADDR|RTMGRP_IPV6_IFADDR|RTMGRP_IPV4_ROUTE|RTMGRP_IPV6_ROUTE;
+
+		if(bind(fd,(struct sockaddr *) &addr,sizeof(addr)) < 0) {
+			int err = errno;
+			::close(fd);
+			throw system_error(err,system_category(),_("Cant bind netlink socket"));
+		}
+
+		values.fd = fd;
+		values.events = oninput;
+
+		try {
+
+			lock_guard<mutex> lock(guard);
+			load();
+
+		} catch(...) {
+
+			close();
+			throw;
+
+		}
+
+		enable();
+
+	}
+
+	Netlink::Monitor::~Monitor() {
+		close();
+	}
+
+	void Netlink::Monitor::load() {
+
+		auto updated = make_shared<Tables>();
+
+		{
+			struct ifinfomsg request;
+			memset(&request,0,sizeof(request));
+			request.ifi_family = AF_UNSPEC;
+			dump(*updated,RTM_GETLINK,&request,sizeof(request));
+		}
+
+		{
+			struct ifaddrmsg request;
+			memset(&request,0,sizeof(request));
+			request.ifa_family = AF_UNSPEC;
+			dump(*updated,RTM_GETADDR,&request,sizeof(request));
+		}
+
+		{
+			struct rtmsg request;
+			memset(&request,0,sizeof(request));
+			request.rtm_family = AF_UNSPEC;
+			dump(*updated,RTM_GETROUTE,&request,sizeof(request));
+		}
+
+		Logger::String{
+			"Got ",updated->links.size()," link(s), ",updated->addresses.size()," address(es) and ",updated->routes.size()," route(s)"
+		}.trace("netlink");
+
+		overrun = false;
+		std::atomic_store(&tables,std::shared_ptr<const Tables>{updated});
+
+	}
+
+	void Netlink::Monitor::dump(Tables &tables, uint16_t type, const void *request, size_t length) {
+
+		struct {
+			struct nlmsghdr header;
+			char payload[64];
+		} message;
+
+		memset(&message,0,sizeof(message));
+		message.header.nlmsg_len = NLMSG_LENGTH(length);
+		message.header.nlmsg_type = type;
+		message.header.nlmsg_flags = NLM_F_REQUEST|NLM_F_DUMP;
+		message.header.nlmsg_seq = ++sequence;
+		memcpy(NLMSG_DATA(&message.header),request,length);
+
+		if(send(values.fd,&message,message.header.nlmsg_len,0) < 0) {
+			throw system_error(errno,system_category(),_("Cant send netlink message"));
+		}
+
+		std::vector<uint16_t> changes;
+		while(!receive(tables,changes,message.header.nlmsg_seq)) {
+
+			// 1 Sec Timeout to avoid stall
+			struct pollfd pfd;
+			pfd.fd = values.fd;
+			pfd.events = POLLIN;
+			pfd.revents = 0;
+
+			int rc = ::poll(&pfd,1,1000);
+			if(rc < 0 && errno != EINTR) {
+				throw system_error(errno,system_category(),_("Cant receive netlink response"));
+			} else if(rc == 0) {
+				throw system_error(ETIMEDOUT,system_category(),_("Cant receive netlink response"));
+			}
+
+		}
+
+	}
+
+	bool Netlink::Monitor::receive(Tables &tables, std::vector<uint16_t> &changes, uint32_t seq) {
+
+		bool done = false;
+
+		while(!done) {
+
+			ssize_t length = recv(values.fd,buffer.data(),buffer.size(),MSG_DONTWAIT);
+
+			if(length < 0) {
+
+				if(errno == EINTR) {
+					continue;
+				}
+
+				if(errno == EAGAIN || errno == EWOULDBLOCK) {
+					break;
+				}
+
+				if(errno == ENOBUFS) {
+					// Kernel has dropped notifications, keep reading and reload the tables.
+					overrun = true;
+					continue;
+				}
+
+				throw system_error(errno,system_category(),_("Cant receive netlink message"));
+
+			}
+
+			if(length == 0) {
+				break;
+			}
+
+			for(struct nlmsghdr *msg = (struct nlmsghdr *) buffer.data(); NLMSG_OK(msg,length); msg = NLMSG_NEXT(msg,length)) {
+
+				if(seq && msg->nlmsg_seq == seq) {
+
+					if(msg->nlmsg_type == NLMSG_DONE) {
+						done = true;
+						continue;
+					}
+
+					if(msg->nlmsg_type == NLMSG_ERROR) {
+						const struct nlmsgerr *err = (const struct nlmsgerr *) NLMSG_DATA(msg);
+						if(err->error) {
+							throw system_error(-err->error,system_category(),_("Netlink request has failed"));
+						}
+						done = true;
+						continue;
+					}
+
+				}
+
+				if(apply(tables,msg)) {
+					changes.push_back(msg->nlmsg_type);
+				}
+
+			}
+
+		}
+
+		return done;
+
+	}
+
+	bool Netlink::Monitor::apply(Tables &tables, const struct nlmsghdr *msg) {
+
+		switch(msg->nlmsg_type) {
+		case RTM_NEWLINK:
+		case RTM_DELLINK:
+			{
+				Link link;
+				if(!link.set(msg)) {
+					return false;
+				}
+
+				bool remove = (msg->nlmsg_type == RTM_DELLINK);
+
+				if(remove) {
+					// Interface is gone, so are its addresses.
+					tables.addresses.erase(
+						std::remove_if(tables.addresses.begin(),tables.addresses.end(),[&link](const Address &address){
+							return address.index == link.index;
+						}),
+						tables.addresses.end()
+					);
+				}
+
+				return update<Link>(tables.links,link,remove,[](const Link &a, const Link &b){
+					return a.index == b.index;
+				});
+
+			}
+
+		case RTM_NEWADDR:
+		case RTM_DELADDR:
+			{
+				if(msg->nlmsg_len < NLMSG_LENGTH(sizeof(struct ifaddrmsg))) {
+					return false;
+				}
+
+				const struct ifaddrmsg *ifa = (const struct ifaddrmsg *) NLMSG_DATA(msg);
+
+				if(ifa->ifa_family != AF_INET && ifa->ifa_family != AF_INET6) {
+					return false;
+				}
+
+				Address address;
+				address.index = ifa->ifa_index;
+				address.prefix = ifa->ifa_prefixlen;
+
+				for_each(IFA_RTA(ifa),IFA_PAYLOAD(msg),[&address,ifa](const struct rtattr *rta){
+
+					switch(rta->rta_type) {
+					case IFA_LOCAL:
+						// On point-to-point links IFA_ADDRESS is the peer, IFA_LOCAL is always the local one.
+						store(address.address,ifa->ifa_family,RTA_DATA(rta),RTA_PAYLOAD(rta));
+						break;
+
+					case IFA_ADDRESS:
+						if(address.address.ss_family == AF_UNSPEC) {
+							store(address.address,ifa->ifa_family,RTA_DATA(rta),RTA_PAYLOAD(rta));
+						}
+						break;
+
+					}
+
+				});
+
+				if(address.address.ss_family == AF_UNSPEC) {
+					return false;
+				}
+
+				netmask(address.netmask,ifa->ifa_family,address.prefix);
+
+				return update<Address>(tables.addresses,address,msg->nlmsg_type == RTM_DELADDR,[](const Address &a, const Address &b){
+					return a.index == b.index && a.address == b.address;
+				});
+
+			}
+
+		case RTM_NEWROUTE:
+		case RTM_DELROUTE:
+			{
+				if(msg->nlmsg_len < NLMSG_LENGTH(sizeof(struct rtmsg))) {
+					return false;
+				}
+
+				const struct rtmsg *rtm = (const struct rtmsg *) NLMSG_DATA(msg);
+
+				// We are just interested on the unicast routes, ignore the cache entries.
+				if((rtm->rtm_family != AF_INET && rtm->rtm_family != AF_INET6) || rtm->rtm_type != RTN_UNICAST || (rtm->rtm_flags & RTM_F_CLONED)) {
+					return false;
+				}
+
+				Route route;
+				route.family = rtm->rtm_family;
+				route.length = rtm->rtm_dst_len;
+				route.table = rtm->rtm_table;
+
+				// ECMP routes list their next hops on RTA_MULTIPATH.
+				const struct rtattr *multipath = nullptr;
+
+				for_each(RTM_RTA(rtm),RTM_PAYLOAD(msg),[&route,&multipath](const struct rtattr *rta){
+
+					switch(rta->rta_type) {
+					case RTA_TABLE:
+						if(RTA_PAYLOAD(rta) >= sizeof(uint32_t)) {
+							route.table = *((const uint32_t *) RTA_DATA(rta));
+						}
+						break;
+
+					case RTA_PRIORITY:
+						if(RTA_PAYLOAD(rta) >= sizeof(uint32_t)) {
+							route.priority = *((const uint32_t *) RTA_DATA(rta));
+						}
+						break;
+
+					case RTA_OIF:
+						if(RTA_PAYLOAD(rta) >= sizeof(int)) {
+							route.oif = *((const int *) RTA_DATA(rta));
+						}
+						break;
+
+					case RTA_DST:
+						store(route.destination,route.family,RTA_DATA(rta),RTA_PAYLOAD(rta));
+						break;
+
+					case RTA_GATEWAY:
+						store(route.gateway,route.family,RTA_DATA(rta),RTA_PAYLOAD(rta));
+						break;
+
+					case RTA_MULTIPATH:
+						multipath = rta;
+						break;
+
+					}
+
+				});
+
+				if(route.table == RT_TABLE_LOCAL) {
+					return false;
+				}
+
+				// One entry for each next hop.
+				std::vector<Route> nexthops;
+
+				if(multipath) {
+
+					const struct rtnexthop *nh = (const struct rtnexthop *) RTA_DATA(multipath);
+					size_t length = RTA_PAYLOAD(multipath);
+
+					while(length >= sizeof(struct rtnexthop) && nh->rtnh_len >= sizeof(struct rtnexthop) && nh->rtnh_len <= length) {
+
+						Route hop{route};
+						hop.oif = nh->rtnh_ifindex;
+						memset(&hop.gateway,0,sizeof(hop.gateway));
+
+						for_each(RTNH_DATA(nh),nh->rtnh_len - RTNH_LENGTH(0),[&hop](const struct rtattr *rta){
+							if(rta->rta_type == RTA_GATEWAY) {
+								store(hop.gateway,hop.family,RTA_DATA(rta),RTA_PAYLOAD(rta));
+							}
+						});
+
+						nexthops.push_back(hop);
+
+						if(length < (size_t) RTNH_ALIGN(nh->rtnh_len)) {
+							break;
+						}
+						length -= (size_t) RTNH_ALIGN(nh->rtnh_len);
+						nh = RTNH_NEXT(nh);
+
+					}
+
+				}
+
+				if(nexthops.empty()) {
+					nexthops.push_back(route);
+				}
+
+				auto destination = [](const Route &a, const Route &b) {
+					return a.family == b.family
+						&& a.table == b.table
+						&& a.length == b.length
+						&& a.priority == b.priority
+						&& a.destination == b.destination;
+				};
+
+				bool changed = false;
+
+				if(msg->nlmsg_type == RTM_NEWROUTE && (msg->nlmsg_flags & NLM_F_REPLACE)) {
+					// The route was replaced, forget its old next hops.
+					auto from = std::remove_if(tables.routes.begin(),tables.routes.end(),[&](const Route &entry){
+						return destination(entry,route);
+					});
+					changed = (from != tables.routes.end());
+					tables.routes.erase(from,tables.routes.end());
+				}
+
+				// ECMP routes share the destination, the next hop is part of the key.
+				std::function<bool(const Route &a, const Route &b)> same{[&destination](const Route &a, const Route &b){
+					return destination(a,b) && a.oif == b.oif && a.gateway == b.gateway;
+				}};
+
+				for(const Route &hop : nexthops) {
+					if(update<Route>(tables.routes,hop,msg->nlmsg_type == RTM_DELROUTE,same)) {
+						changed = true;
+					}
+				}
+
+				return changed;
+
+			}
+
+		}
+
+		return false;
+
+	}
+
+	void Netlink::Monitor::flush() {
+
+		std::vector<uint16_t> changes;
+		std::vector<std::function<void(uint16_t type)>> calls;
+
+		{
+			lock_guard<mutex> lock(guard);
+
+			if(values.fd == -1) {
+				return;
+			}
+
+			// Check for pending messages before copying the tables.
+			struct pollfd pfd;
+			pfd.fd = values.fd;
+			pfd.events = POLLIN;
+			pfd.revents = 0;
+
+			if(::poll(&pfd,1,0) <= 0 || !(pfd.revents & POLLIN)) {
+				return;
+			}
+
+			auto updated = make_shared<Tables>(*std::atomic_load(&tables));
+			receive(*updated,changes,0);
+
+			if(overrun) {
+				Logger::String{"Netlink socket overrun, reloading tables"}.warning("netlink");
+				load();
+				changes.clear();
+				changes.push_back(0);
+			} else if(!changes.empty()) {
+				std::atomic_store(&tables,std::shared_ptr<const Tables>{updated});
+			}
+
+			if(changes.empty()) {
+				return;
+			}
+
+			for(const Listener &listener : listeners) {
+				calls.push_back(listener.call);
+			}
+
+		}
+
+		// Call listeners without lock, they can query the tables.
+		for(uint16_t type : changes) {
+			for(const auto &call : calls) {
+				try {
+					call(type);
+				} catch(const std::exception &e) {
+					Logger::String{e.what()}.error("netlink");
+				}
+			}
+		}
+
+	}
+
+	void Netlink::Monitor::handle_event(const Event event) {
+
+		if(event & oninput) {
+			flush();
+		} else if(event & (onerror|onhangup)) {
+			Logger::String{"Netlink socket was closed"}.error("netlink");
+			disable();
+		}
+
+	}
+
+	std::shared_ptr<const Netlink::Monitor::Tables> Netlink::Monitor::get() {
+		flush();
+		return std::atomic_load(&tables);
+	}
+
+	void Netlink::Monitor::push_back(const void *id, const std::function<void(uint16_t type)> &call) {
+		lock_guard<mutex> lock(guard);
+		listeners.push_back(Listener{id,call});
+	}
+
+	void Netlink::Monitor::remove(const void *id) {
+		lock_guard<mutex> lock(guard);
+		listeners.remove_if([id](const Listener &listener){
+			return listener.id == id;
+		});
+	}
+
+ }
@@ -45,33 +45,55 @@
  class UDJAT_PRIVATE NamedInterface : public Udjat::Network::Interface {
  private:
 
-	void get(struct ifreq &ifr) const noexcept {
-		memset(&ifr,0,sizeof(ifr));
-		strncpy(ifr.ifr_name,nicname.c_str(),sizeof(ifr.ifr_name)-1);
+	std::string nicname;
+
+	/// @brief Tables captured by the interface enumeration (empty to use the current ones).
+	std::shared_ptr<const Udjat::Netlink::Monitor::Tables> snapshot;
+
+	std::shared_ptr<const Udjat::Netlink::Monitor::Tables> tables() const {
+		if(snapshot) {
+			return snapshot;
+		}
+		return Udjat::Netlink::Monitor::getInstance().get();
 	}
 
-	std::string nicname;
+	/// @brief Get the link from the netlink tables.
+	const Udjat::Netlink::Link & link(const Udjat::Netlink::Monitor::Tables &tables) const {
+		const Udjat::Netlink::Link *link = tables.find(nicname.c_str());
+		if(!link) {
+			throw system_error(ENODEV,system_category(),nicname);
+		}
+		return *link;
+	}
+
+	/// @brief Get the first IPv4 address of the interface.
+	const Udjat::Netlink::Address & ipv4(const Udjat::Netlink::Monitor::Tables &tables) const {
+		int index = link(tables).index;
+		for(const Udjat::Netlink::Address &address : tables.addresses) {
+			if(address.index == index && address.address.ss_family == AF_INET) {
+				return address;
+			}
+		}
+		throw system_error(EADDRNOTAVAIL,system_category(),nicname);
+	}
 
 	unsigned int flags() const {
-		Socket sock{PF_INET,SOCK_STREAM,0};
-		struct ifreq ifr;
-		get(ifr);
-		sock.ioctl(SIOCGIFFLAGS, ifr);
-		return ifr.ifr_flags;
+		return link(*tables()).flags;
 	 }
 	
 public:
 	NamedInterface(const char *name) : nicname{name} {
 	}
 
+	NamedInterface(const char *name, const std::shared_ptr<const Udjat::Netlink::Monitor::Tables> &tables) : nicname{name}, snapshot{tables} {
+	}
+
 	bool operator==(const sockaddr_storage &addr) const override {
 		throw system_error(ENOTSUP,system_category(),"Unsupported method call");
 	}
 
 	bool found() const {
-		return for_each([this](const char *intf) {
-			return strcmp(intf,name()) == 0;
-		});
+		return tables()->find(nicname.c_str()) != nullptr;
 	}
 
 	const char * name() const override {
@@ -87,39 +109,47 @@ public:
 	}
 
 	Udjat::IP::Address address() const override {
-		Socket sock{PF_INET,SOCK_STREAM,0};
-		struct ifreq ifr;
-		get(ifr);
-		sock.ioctl(SIOCGIFADDR,ifr);
-		return Udjat::IP::Address{&ifr.ifr_addr};
+		return Udjat::IP::Address{ipv4(*tables()).address};
 	}
 
 	Udjat::IP::Address netmask() const override {
-		Socket sock{PF_INET,SOCK_STREAM,0};
-		struct ifreq ifr;
-		get(ifr);
-		sock.ioctl(SIOCGIFNETMASK,ifr);
-		return Udjat::IP::Address{&ifr.ifr_netmask};
+		return Udjat::IP::Address{ipv4(*tables()).netmask};
 	}
 
 	std::string macaddress() const override {
-		
-		Socket sock{PF_INET,SOCK_STREAM,0};
+		return link(*tables()).macaddress;
+	}
 
-		struct ifreq ifr;
-		get(ifr);
+	Udjat::Value & getProperties(Udjat::Value &value) const override {
 
-		sock.ioctl(SIOCGIFHWADDR,ifr);
+		Udjat::Network::Interface::getProperties(value);
 
-		std::string mac;
-		static const char *digits = "0123456789ABCDEF";
-		for(size_t ix = 0; ix < 6; ix++) {
-			uint8_t digit = * (((unsigned char *) ifr.ifr_hwaddr.sa_data+ix));
-			mac += digits[(digit >> 4) & 0x0f];
-			mac += digits[digit & 0x0f];
+		// The enumeration snapshot has current counters, otherwise get them for this link only.
+		// Counters are exported as real numbers, the value has no 64 bits integer.
+		Udjat::Netlink::Link current;
+		if(snapshot) {
+			current = link(*snapshot);
+		} else {
+			auto links = Udjat::Netlink::Link::snapshot(link(*tables()).index);
+			if(links.empty()) {
+				throw system_error(ENODEV,system_category(),nicname);
+			}
+			current = links.front();
 		}
 
-		return mac;
+		value["mtu"] = current.mtu;
+		value["operstate"] = current.state();
+		value["rx_packets"] = (double) current.stats.rx_packets;
+		value["tx_packets"] = (double) current.stats.tx_packets;
+		value["rx_bytes"] = (double) current.stats.rx_bytes;
+		value["tx_bytes"] = (double) current.stats.tx_bytes;
+		value["rx_errors"] = (double) current.stats.rx_errors;
+		value["tx_errors"] = (double) current.stats.tx_errors;
+		value["rx_dropped"] = (double) current.stats.rx_dropped;
+		value["tx_dropped"] = (double) current.stats.tx_dropped;
+
+		return value;
+
 	}
 
  };
@@ -156,99 +186,54 @@ public:
 
 	bool Network::Interface::for_each(const std::function<bool(const char *name)> &func) {
 
-		bool rc = false;
-
-		// https://stackoverflow.com/questions/19227781/linux-getting-all-network-interface-names
-		struct if_nameindex *if_nidxs;
-
-		if_nidxs = if_nameindex();
-		if(!if_nidxs) {
-			throw std::system_error(errno,std::system_category());
-		}
-
-		try {
+		auto tables = Netlink::Monitor::getInstance().get();
 
-			for(struct if_nameindex *intf = if_nidxs; intf->if_index != 0 || intf->if_name != NULL; intf++) {
-				if(func(intf->if_name)) {
-					rc = true;
-					break;
-				}
+		for(const Netlink::Link &link : tables->links) {
+			if(func(link.name.c_str())) {
+				return true;
 			}
-
-		} catch(...) {
-
-			if_freenameindex(if_nidxs);
-			throw;
-
 		}
 
-		if_freenameindex(if_nidxs);
-		return rc;
+		return false;
 
     }
 
    	bool Network::Interface::for_each(const std::function<bool(const Network::Interface &intf)> &func) {
 
-		bool rc = false;
-
-		// https://stackoverflow.com/questions/19227781/linux-getting-all-network-interface-names
-		struct if_nameindex *if_nidxs;
-
-		if_nidxs = if_nameindex();
-		if(!if_nidxs) {
-			throw std::system_error(errno,std::system_category());
-		}
-
-		try {
+		// One RTM_GETLINK dump for all interfaces, the addresses are already on the monitor tables.
+		auto tables = make_shared<Netlink::Monitor::Tables>(*Netlink::Monitor::getInstance().get());
+		tables->links = Netlink::Link::snapshot();
 
-			for(struct if_nameindex *intf = if_nidxs; intf->if_index != 0 || intf->if_name != NULL; intf++) {
-				if(func(*Factory(intf->if_name))) {
-					rc = true;
-					break;
-				}
+		for(const Netlink::Link &link : tables->links) {
+			NamedInterface intf{link.name.c_str(),tables};
+			if(func(intf)) {
+				return true;
 			}
-
-		} catch(...) {
-
-			if_freenameindex(if_nidxs);
-			throw;
-
 		}
 
-		if_freenameindex(if_nidxs);
-		return rc;
+		return false;
 
 	}
 
 	std::shared_ptr<Network::Interface> Network::Interface::Default() {
 
-		char ifname[IF_NAMESIZE];
-
-		if(!netlink_routes([&](const struct nlmsghdr *nlh) -> bool {
+		auto tables = Netlink::Monitor::getInstance().get();
 
-			struct rtmsg *rtm = (struct rtmsg *)NLMSG_DATA(nlh);
-            struct rtattr *rta = (struct rtattr *)((char *)rtm +sizeof(struct rtmsg));
+		for(int family : { AF_INET, AF_INET6 }) {
 
-            // Iterate over route attributes
-            while (RTA_OK(rta, nlh->nlmsg_len - (rta - (struct rtattr *)rtm))) {
-                if (rta->rta_type == RTA_OIF) {
-                    int ifindex = *(int *)RTA_DATA(rta);
-                    if (if_indextoname(ifindex, ifname) != NULL) {
-						return true;
-					}
-                }
+			const Netlink::Route *route = tables->route(family);
+			if(!route || !route->oif) {
+				continue;
+			}
 
-				size_t attrlen = nlh->nlmsg_len - (rta - (struct rtattr *)rtm);
-                rta = RTA_NEXT(rta, attrlen);
-            }
+			const Netlink::Link *link = tables->find(route->oif);
+			if(link) {
+				return make_shared<NamedInterface>(link->name.c_str());
+			}
 
-			return false;
-	
-		})) {
-			throw runtime_error("Unable to find default interface");
 		}
 
-		return make_shared<NamedInterface>(ifname);
+		throw runtime_error("Unable to find default interface");
 
 	}
 
@@ -0,0 +1,282 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements the /proc and /sys file reader.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/system.h>
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <system_error>
+ #include <cstring>
+ #include <cstdlib>
+ #include <cctype>
+ #include <cerrno>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	System::ProcFile::ProcFile(const char *filename, const char sep) : separator{sep} {
+
+		fd = open(filename,O_RDONLY|O_CLOEXEC);
+		if(fd < 0) {
+			throw system_error(errno,system_category(),filename);
+		}
+
+		buffer.resize(4096);
+		refresh();
+
+	}
+
+	System::ProcFile::~ProcFile() {
+		if(fd >= 0) {
+			::close(fd);
+		}
+	}
+
+	System::ProcFile & System::ProcFile::refresh() {
+
+		// The pseudo files are generated on read, they must be read from offset 0 until EOF.
+		length = 0;
+		for(;;) {
+
+			if(buffer.size() - length < 2) {
+				buffer.resize(buffer.size() * 2);
+			}
+
+			ssize_t bytes = pread(fd,buffer.data()+length,buffer.size()-length-1,length);
+			if(bytes < 0) {
+				if(errno == EINTR) {
+					continue;
+				}
+				throw system_error(errno,system_category(),"Cant read pseudo file");
+			}
+
+			if(bytes == 0) {
+				break;
+			}
+
+			length += bytes;
+		}
+
+		buffer[length] = 0;
+		stale = true;
+
+		return *this;
+
+	}
+
+	void System::ProcFile::scan() {
+
+		index.clear();
+		keys.clear();
+
+		// The keys are shorter than the contents, no reallocation will move the views.
+		keys.reserve(length);
+
+		const char *text = buffer.data();
+		size_t offset = 0;
+
+		while(offset < length) {
+
+			const char *eol = (const char *) memchr(text+offset,'\n',length-offset);
+			size_t next = eol ? (eol - text) + 1 : length;
+
+			const char *ptr = text+offset;
+			while(ptr < text+next && (*ptr == ' ' || *ptr == '\t')) {
+				ptr++;
+			}
+
+			const char *end = ptr;
+			while(end < text+next && *end != '\n' && (separator == ' ' ? !isspace(*end) : *end != separator)) {
+				end++;
+			}
+
+			// Strip trailing blanks ("Key   : value").
+			const char *key = end;
+			while(key > ptr && isblank(key[-1])) {
+				key--;
+			}
+
+			if(key > ptr) {
+				// Keep the first occurrence.
+				size_t from = keys.size();
+				keys.append(ptr,(size_t) (key-ptr));
+				index.emplace(string_view{keys.data()+from,(size_t) (key-ptr)},offset);
+			}
+
+			offset = next;
+
+		}
+
+		stale = false;
+
+	}
+
+	size_t System::ProcFile::locate(const char *key) {
+
+		const char *text = buffer.data();
+
+		if(!key) {
+			// No key, the value is the first line.
+			return 0;
+		}
+
+		size_t keylen = strlen(key);
+
+		for(int pass = 0; pass < 2; pass++) {
+
+			if(pass && !stale) {
+				break;
+			}
+
+			if(pass || index.empty()) {
+				scan();
+			}
+
+			auto it = index.find(string_view{key,keylen});
+			if(it == index.end()) {
+				continue;
+			}
+
+			// Check if the key is still at the same offset.
+			size_t offset = it->second;
+			if(offset >= length || (offset && text[offset-1] != '\n')) {
+				continue;
+			}
+
+			const char *ptr = text+offset;
+			while(*ptr == ' ' || *ptr == '\t') {
+				ptr++;
+			}
+
+			if(strncmp(ptr,key,keylen)) {
+				continue;
+			}
+
+			ptr += keylen;
+
+			// The key must end here, not be the prefix of another one.
+			if(*ptr && *ptr != '\n' && *ptr != separator && !isblank(*ptr)) {
+				continue;
+			}
+
+			while(isblank(*ptr) && *ptr != separator) {
+				ptr++;
+			}
+
+			if(separator != ' ') {
+				if(*ptr != separator) {
+					continue;
+				}
+				ptr++;
+			}
+
+			while(isblank(*ptr)) {
+				ptr++;
+			}
+
+			return ptr - text;
+
+		}
+
+		return string::npos;
+
+	}
+
+	std::string_view System::ProcFile::get(const char *key) {
+
+		size_t offset = locate(key);
+		if(offset == string::npos) {
+			return std::string_view{};
+		}
+
+		const char *ptr = buffer.data()+offset;
+		const char *eol = (const char *) memchr(ptr,'\n',length-offset);
+		size_t len = eol ? (size_t) (eol - ptr) : (length - offset);
+
+		while(len && isspace(ptr[len-1])) {
+			len--;
+		}
+
+		return std::string_view{ptr,len};
+
+	}
+
+	unsigned long long System::ProcFile::as_ull(const char *key, unsigned long long def) {
+		size_t offset = locate(key);
+		if(offset == string::npos || buffer[offset] == '\n') {
+			return def;
+		}
+		char *end = nullptr;
+		unsigned long long value = strtoull(buffer.data()+offset,&end,10);
+		return end == buffer.data()+offset ? def : value;
+	}
+
+	long long System::ProcFile::as_ll(const char *key, long long def) {
+		size_t offset = locate(key);
+		if(offset == string::npos || buffer[offset] == '\n') {
+			return def;
+		}
+		char *end = nullptr;
+		long long value = strtoll(buffer.data()+offset,&end,10);
+		return end == buffer.data()+offset ? def : value;
+	}
+
+	double System::ProcFile::as_double(const char *key, double def) {
+		size_t offset = locate(key);
+		if(offset == string::npos || buffer[offset] == '\n') {
+			return def;
+		}
+		char *end = nullptr;
+		double value = strtod(buffer.data()+offset,&end);
+		return end == buffer.data()+offset ? def : value;
+	}
+
+	size_t System::ProcFile::get(const char *key, unsigned long long *values, size_t count) {
+
+		size_t offset = locate(key);
+		if(offset == string::npos || buffer[offset] == '\n') {
+			return 0;
+		}
+
+		const char *ptr = buffer.data()+offset;
+		size_t parsed = 0;
+		while(parsed < count && *ptr && *ptr != '\n') {
+			char *end = nullptr;
+			values[parsed] = strtoull(ptr,&end,10);
+			if(end == ptr) {
+				break;
+			}
+			parsed++;
+			ptr = end;
+			while(*ptr == ' ' || *ptr == '\t') {
+				ptr++;
+			}
+		}
+
+		return parsed;
+
+	}
+
+ }
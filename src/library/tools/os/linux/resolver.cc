@@ -0,0 +1,400 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements the cached name resolver.
+  *
+  * References:
+  *
+  * <https://www.rfc-editor.org/rfc/rfc8305>
+  *
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <private/linux/resolver.h>
+ #include <udjat/tools/logger.h>
+ #include <udjat/tools/configuration.h>
+ #include <sys/types.h>
+ #include <sys/socket.h>
+ #include <sys/poll.h>
+ #include <netdb.h>
+ #include <unistd.h>
+ #include <fcntl.h>
+ #include <cstring>
+ #include <ctime>
+ #include <chrono>
+ #include <condition_variable>
+ #include <deque>
+ #include <future>
+ #include <mutex>
+ #include <string>
+ #include <system_error>
+ #include <thread>
+ #include <unordered_map>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief A pending lookup.
+	struct Lookup {
+		string key;
+		string hostname;
+		string service;
+		shared_ptr<promise<shared_ptr<const Resolver::Result>>> result;
+	};
+
+	/// @brief A cached lookup.
+	struct CacheEntry {
+		shared_future<shared_ptr<const Resolver::Result>> result;
+		time_t expires = 0;		///< @brief Expiration time (0 while the lookup is running).
+	};
+
+	/// @brief Resolver state.
+	/// @details Never destroyed, the resolver threads can still be waiting on getaddrinfo() at exit.
+	struct ResolverState {
+
+		mutex guard;
+		condition_variable wakeup;
+
+		unordered_map<string,CacheEntry> cache;
+		deque<Lookup> queue;
+
+		size_t threads = 0;
+		size_t idle = 0;
+
+		size_t max_threads;
+		size_t max_entries;
+		time_t ttl;
+		time_t negative_ttl;
+
+		ResolverState() {
+			max_threads = Config::Value<unsigned int>("network","resolver-threads",4).get();
+			max_entries = Config::Value<unsigned int>("network","dns-cache-size",256).get();
+			ttl = Config::Value<unsigned int>("network","dns-cache-ttl",60).get();
+			negative_ttl = Config::Value<unsigned int>("network","dns-negative-ttl",10).get();
+			if(!max_threads) {
+				max_threads = 1;
+			}
+		}
+
+		static ResolverState & getInstance() {
+			static ResolverState *instance = new ResolverState();
+			return *instance;
+		}
+
+		/// @brief Remove expired entries, the oldest ones if still full.
+		void expire(time_t now) {
+
+			for(auto it = cache.begin(); it != cache.end();) {
+				if(it->second.expires && it->second.expires <= now) {
+					it = cache.erase(it);
+				} else {
+					it++;
+				}
+			}
+
+			while(cache.size() >= max_entries) {
+				auto oldest = cache.end();
+				for(auto it = cache.begin(); it != cache.end(); it++) {
+					if(it->second.expires && (oldest == cache.end() || it->second.expires < oldest->second.expires)) {
+						oldest = it;
+					}
+				}
+				if(oldest == cache.end()) {
+					break;	// Everything is running.
+				}
+				cache.erase(oldest);
+			}
+
+		}
+
+		static shared_ptr<const Resolver::Result> lookup(const Lookup &request) noexcept {
+
+			auto result = make_shared<Resolver::Result>();
+
+			struct addrinfo hints;
+			struct addrinfo * addresses = NULL;
+			memset(&hints,0,sizeof(hints));
+
+			hints.ai_family		= AF_UNSPEC;	// Allow IPv4 or IPv6
+			hints.ai_socktype	= SOCK_STREAM;	// Stream socket
+			hints.ai_flags		= AI_PASSIVE;	// For wildcard IP address
+			hints.ai_protocol	= 0;			// Any protocol
+
+			result->error = getaddrinfo(request.hostname.c_str(), request.service.c_str(), &hints, &addresses);
+			if(!result->error) {
+				for(struct addrinfo *rp = addresses; rp; rp = rp->ai_next) {
+					if(rp->ai_addrlen > sizeof(sockaddr_storage)) {
+						continue;
+					}
+					Resolver::Address address;
+					address.family = rp->ai_family;
+					address.socktype = rp->ai_socktype;
+					address.protocol = rp->ai_protocol;
+					address.length = rp->ai_addrlen;
+					memcpy(&address.addr,rp->ai_addr,rp->ai_addrlen);
+					result->addresses.push_back(address);
+				}
+				freeaddrinfo(addresses);
+			}
+
+			return result;
+
+		}
+
+		/// @brief Resolver thread.
+		void worker() noexcept {
+
+			unique_lock<mutex> lock(guard);
+
+			while(true) {
+
+				if(queue.empty()) {
+					idle++;
+					wakeup.wait(lock,[this]{ return !queue.empty(); });
+					idle--;
+				}
+
+				Lookup request{std::move(queue.front())};
+				queue.pop_front();
+
+				lock.unlock();
+				auto result = lookup(request);
+				lock.lock();
+
+				auto it = cache.find(request.key);
+				if(it != cache.end()) {
+					it->second.expires = time(0) + (result->error ? negative_ttl : ttl);
+				}
+
+				request.result->set_value(result);
+
+			}
+
+		}
+
+	};
+
+	std::shared_ptr<const Resolver::Result> Resolver::resolve(const char *hostname, const char *service, unsigned int seconds) {
+
+		ResolverState &state = ResolverState::getInstance();
+
+		string key{hostname};
+		key += '/';
+		key += service;
+
+		shared_future<shared_ptr<const Result>> result;
+
+		{
+			lock_guard<mutex> lock(state.guard);
+
+			time_t now = time(0);
+			auto it = state.cache.find(key);
+
+			if(it != state.cache.end() && (!it->second.expires || it->second.expires > now)) {
+
+				// Cached or running.
+				result = it->second.result;
+
+			} else {
+
+				if(it != state.cache.end()) {
+					state.cache.erase(it);
+				}
+
+				if(state.cache.size() >= state.max_entries) {
+					state.expire(now);
+				}
+
+				Lookup request{key,hostname,service,make_shared<promise<shared_ptr<const Result>>>()};
+				result = request.result->get_future().share();
+				state.cache[key].result = result;
+				state.queue.push_back(std::move(request));
+
+				if(state.idle) {
+					state.wakeup.notify_one();
+				} else if(state.threads < state.max_threads) {
+					state.threads++;
+					std::thread{[&state]{ state.worker(); }}.detach();
+				}
+
+			}
+
+		}
+
+		if(result.wait_for(std::chrono::seconds(seconds)) != std::future_status::ready) {
+			throw system_error(ETIMEDOUT,system_category(),Logger::String{"Timeout resolving '",hostname,"'"});
+		}
+
+		return result.get();
+
+	}
+
+	int Resolver::connect(const std::vector<Address> &addresses, unsigned int seconds) noexcept {
+
+		if(addresses.empty()) {
+			errno = ENOENT;
+			return -1;
+		}
+
+		// Alternate the address families, starting with the first one returned by the resolver.
+		vector<const Address *> order;
+		{
+			vector<const Address *> primary, secondary;
+			int family = addresses[0].family;
+			for(const Address &address : addresses) {
+				(address.family == family ? primary : secondary).push_back(&address);
+			}
+			for(size_t ix = 0; ix < primary.size() || ix < secondary.size(); ix++) {
+				if(ix < primary.size()) {
+					order.push_back(primary[ix]);
+				}
+				if(ix < secondary.size()) {
+					order.push_back(secondary[ix]);
+				}
+			}
+		}
+
+		int delay = (int) Config::Value<unsigned int>("network","connection-attempt-delay",250).get();
+		auto deadline = chrono::steady_clock::now() + chrono::seconds(seconds);
+
+		vector<struct pollfd> attempts;
+		size_t next = 0;
+		int error = ETIMEDOUT;
+		int connected = -1;
+
+		auto close_all = [&attempts]() {
+			for(auto &attempt : attempts) {
+				::close(attempt.fd);
+			}
+			attempts.clear();
+		};
+
+		// Start the next attempt, return false if there's no more addresses.
+		auto start = [&]() -> bool {
+
+			while(next < order.size() && connected < 0) {
+
+				const Address *address = order[next++];
+
+				int sock = socket(address->family, address->socktype|SOCK_NONBLOCK|SOCK_CLOEXEC, address->protocol);
+				if(sock < 0) {
+					error = errno;
+					continue;
+				}
+
+				if(!::connect(sock,(const struct sockaddr *) &address->addr, address->length)) {
+					connected = sock;
+					return true;
+				}
+
+				if(errno != EINPROGRESS) {
+					error = errno;
+					::close(sock);
+					continue;
+				}
+
+				struct pollfd pfd;
+				memset(&pfd,0,sizeof(pfd));
+				pfd.fd = sock;
+				pfd.events = POLLOUT;
+				attempts.push_back(pfd);
+				return true;
+
+			}
+
+			return false;
+
+		};
+
+		start();
+
+		while(connected < 0 && !attempts.empty()) {
+
+			int remaining = (int) chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+			if(remaining <= 0) {
+				error = ETIMEDOUT;
+				break;
+			}
+
+			int timeout = (next < order.size() && delay < remaining) ? delay : remaining;
+
+			int rc = poll(attempts.data(),attempts.size(),timeout);
+
+			if(rc < 0) {
+				if(errno == EINTR) {
+					continue;
+				}
+				error = errno;
+				break;
+			}
+
+			if(rc == 0) {
+				// Still pending after the attempt delay, start another one.
+				start();
+				continue;
+			}
+
+			bool failed = false;
+			for(auto it = attempts.begin(); it != attempts.end() && connected < 0;) {
+
+				if(!it->revents) {
+					it++;
+					continue;
+				}
+
+				int so_error = 0;
+				socklen_t len = sizeof(so_error);
+				if(getsockopt(it->fd, SOL_SOCKET, SO_ERROR, &so_error, &len) < 0) {
+					so_error = errno;
+				}
+
+				if(!so_error && (it->revents & POLLOUT)) {
+					connected = it->fd;
+					it = attempts.erase(it);
+					break;
+				}
+
+				error = so_error ? so_error : ECONNREFUSED;
+				::close(it->fd);
+				it = attempts.erase(it);
+				failed = true;
+
+			}
+
+			if(failed && connected < 0) {
+				// Don't wait for the delay after a failure.
+				start();
+			}
+
+		}
+
+		close_all();
+
+		if(connected < 0) {
+			errno = error;
+		}
+
+		return connected;
+
+	}
+
+ }
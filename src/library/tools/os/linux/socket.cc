@@ -39,37 +39,91 @@
  #include <string.h>
  #include <sys/ioctl.h>
  #include <fcntl.h>
+ #include <sys/uio.h>
+ #include <udjat/tools/timer.h>
+ #include <private/linux/resolver.h>
+ #include <algorithm>
 
  using namespace std;
 
  namespace Udjat {
 
-	Socket::Socket(const URL &url, unsigned int seconds) {
+	/// @brief Maximum number of buffers on a single sendmsg() call.
+	static const size_t MAX_IOV = 64;
 
-		if(seconds < 1) {
-			seconds = Config::Value<unsigned int>("network","timeout",5000).get();
+	/// @brief Timer checking the socket timeouts.
+	class Socket::Watchdog : public MainLoop::Timer {
+	private:
+		Socket &socket;
+
+	protected:
+		void on_timer() override;
+
+	public:
+		Timeouts timeouts;
+
+		unsigned long started;		///< @brief When the timeouts were set.
+		unsigned long activity;		///< @brief Last read or write.
+		unsigned long waiting = 0;	///< @brief Last write not followed by a read (0 if none).
+
+		Watchdog(Socket &s) : socket{s}, started{getCurrentTime()}, activity{started} {
+		}
+
+		inline void received() noexcept {
+			activity = getCurrentTime();
+			waiting = 0;
 		}
 
-        struct addrinfo   hints;
-        struct addrinfo * result        = NULL;
-        memset(&hints,0,sizeof(hints));
+		inline void sent() noexcept {
+			activity = waiting = getCurrentTime();
+		}
 
-        hints.ai_family         = AF_UNSPEC;    // Allow IPv4 or IPv6
-        hints.ai_socktype       = SOCK_STREAM;  // Stream socket
-        hints.ai_flags          = AI_PASSIVE;   // For wildcard IP address
-        hints.ai_protocol       = 0;            // Any protocol
+	};
+
+	void Socket::Watchdog::on_timer() {
+
+		unsigned long now = getCurrentTime();
+
+		if(socket.connecting) {
+			if(timeouts.connect && (now - started) >= timeouts.connect) {
+				disable();
+				socket.connecting = false;
+				socket.close();
+				socket.handle_connect(ETIMEDOUT);
+			}
+			return;
+		}
+
+		if(socket.values.fd == -1) {
+			disable();
+			return;
+		}
 
-		// TODO: Use getaddrinfo_a to resolve in parallel
-        int rc = getaddrinfo(url.hostname().c_str(), url.servicename().c_str(), &hints, &result);
-        if(rc) {
-			throw Exception(rc, Logger::String{"Failed to resolve '",url.c_str(),"'"},gai_strerror(rc));
+		if( (timeouts.read && waiting && (now - waiting) >= timeouts.read) || (timeouts.idle && (now - activity) >= timeouts.idle) ) {
+			// Restart the counters, the socket can be kept open by handle_timeout().
+			activity = now;
+			waiting = 0;
+			socket.handle_timeout();
+		}
+
+	}
+
+	Socket::Socket(const URL &url, unsigned int seconds) {
+
+		if(seconds < 1) {
+			seconds = Config::Value<unsigned int>("network","timeout",10).get();
+		}
+
+		auto result = Resolver::resolve(url.hostname().c_str(), url.servicename().c_str(), seconds);
+		if(result->error) {
+			throw Exception(result->error, Logger::String{"Failed to resolve '",url.c_str(),"'"},gai_strerror(result->error));
 		}
 
 		int error = 0;
 		int sock = -1;
-		for(struct addrinfo *rp = result; rp; rp = rp->ai_next) {
+		for(const auto &address : result->addresses) {
 
-			sock = socket(rp->ai_family, rp->ai_socktype, rp->ai_protocol);
+			sock = socket(address.family, address.socktype, address.protocol);
 			if(sock < 0) {
 				continue;
 			}
@@ -90,7 +144,7 @@
 				continue;
 			}
 
-			if(::connect(sock,rp->ai_addr, rp->ai_addrlen) && errno != EINPROGRESS) {
+			if(::connect(sock,(const struct sockaddr *) &address.addr, address.length) && errno != EINPROGRESS) {
 				error = errno;
 				::close(sock);
 				sock = -1;
@@ -100,8 +154,6 @@
 			break;
 		}
 
-		freeaddrinfo(result);
-
 		if(sock < 0 && error > 0) {
 
 			if(error > 0) {
@@ -137,11 +189,30 @@
 		
 	Socket::~Socket() {
 		close();
+		delete watchdog;
 	}
 
 	void Socket::close() {
-		close(values.fd);
-		values.fd = -1;
+
+		if(watchdog) {
+			watchdog->disable();
+		}
+
+		if(values.fd != -1) {
+			disable();
+			close(values.fd);
+			values.fd = -1;
+		}
+
+		{
+			lock_guard<recursive_mutex> lock(guard);
+			output.queue.clear();
+			output.length = 0;
+			output.paused = false;
+		}
+
+		input.offset = input.length = 0;
+
 	}
 
 	void Socket::close(int sock) noexcept {
@@ -279,48 +350,55 @@
 
 		try {
 
-			if(event & MainLoop::Handler::onoutput) {
+			if(connecting) {
 
-				if(connecting) {
+				if(!(event & (MainLoop::Handler::onoutput|MainLoop::Handler::onerror|MainLoop::Handler::onhangup))) {
+					return;
+				}
 
-					set((Event) (MainLoop::Handler::oninput|MainLoop::Handler::onhangup|MainLoop::Handler::onerror));
-					connecting = false;
+				connecting = false;
 
-					struct sockaddr_storage addr;
-					socklen_t len = sizeof(addr);
+				struct sockaddr_storage addr;
+				socklen_t len = sizeof(addr);
 
-					int error = 0;
-					socklen_t errlen = sizeof(error);
+				int error = 0;
+				socklen_t errlen = sizeof(error);
 
-					if(getsockopt(values.fd, SOL_SOCKET, SO_ERROR, (void *)&error, &errlen) < 0) {
+				if(getsockopt(values.fd, SOL_SOCKET, SO_ERROR, (void *)&error, &errlen) < 0) {
 
-						error = errno;
+					error = errno;
 
-					} else if (getpeername(values.fd, (struct sockaddr *)&addr, &len) == -1) {
+				} else if (getpeername(values.fd, (struct sockaddr *)&addr, &len) == -1) {
 
-						error = errno;
+					error = errno;
 
-					} else if(Logger::enabled(Logger::Trace)) {
-
-						char host[NI_MAXHOST];
-						if (getnameinfo((struct sockaddr *) &addr, sizeof(addr), host, sizeof(host), NULL, 0, NI_NUMERICHOST) == 0) {
-							Logger::String{"Connecting to ",host," using socket ",values.fd}.trace();
-						}
+				} else if(Logger::enabled(Logger::Trace)) {
 
+					char host[NI_MAXHOST];
+					if (getnameinfo((struct sockaddr *) &addr, sizeof(addr), host, sizeof(host), NULL, 0, NI_NUMERICHOST) == 0) {
+						Logger::String{"Connecting to ",host," using socket ",values.fd}.trace();
 					}
 
-					if(error) {
-						disable();
-						close();
-					}
+				}
 
+				if(error) {
+					close();
 					handle_connect(error);
+					return;
+				}
 
-				} else {
+				if(watchdog) {
+					watchdog->received();
+				}
 
-					handle_write_ok();
+				update();
+				handle_connect(0);
 
+				// Send the data queued while connecting.
+				if(values.fd != -1 && output.length) {
+					send();
 				}
+
 				return;
 			}
 
@@ -330,19 +408,35 @@
 				if(getsockopt(values.fd, SOL_SOCKET, SO_ERROR, (void *)&error, &errlen) < 0) {
 					error = errno;
 				}
-				disable();
 				close();
 				handle_error(error);
 				return;
 			}
 
+			// Read before handling hangup, the peer could have sent data before closing.
+			if((event & MainLoop::Handler::oninput) && !receive()) {
+				return;
+			}
+
 			if(event & MainLoop::Handler::onhangup) {
-				disable();
 				close();
 				handle_disconnect();
 				return;
 			}
 
+			if(event & MainLoop::Handler::onoutput) {
+				bool empty;
+				{
+					lock_guard<recursive_mutex> lock(guard);
+					empty = output.queue.empty();
+				}
+				if(empty) {
+					handle_write_ok();
+				} else {
+					send();
+				}
+			}
+
 		} catch(...) {
 
 			close();
@@ -352,6 +446,394 @@
 
 	}
 
+	void Socket::update() noexcept {
+
+		lock_guard<recursive_mutex> lock(guard);
+
+		Event events;
+
+		if(connecting) {
+			events = MainLoop::Handler::onoutput;
+		} else {
+			events = (Event) (MainLoop::Handler::onhangup|MainLoop::Handler::onerror);
+			if(available() < input.limit) {
+				events = (Event) (events|MainLoop::Handler::oninput);
+			}
+			if(!output.queue.empty()) {
+				events = (Event) (events|MainLoop::Handler::onoutput);
+			}
+		}
+
+		if(events != values.events) {
+			set(events);
+		}
+
+	}
+
+	bool Socket::receive() {
+
+		bool received = false;
+
+		if(input.offset == input.length) {
+			input.offset = input.length = 0;
+		}
+
+		while(available() < input.limit) {
+
+			// Keep at least 4K of free space, move the unread data to the buffer start before growing it.
+			if(input.buffer.size() - input.length < 4096) {
+
+				if(input.offset) {
+					memmove(input.buffer.data(),input.buffer.data()+input.offset,input.length - input.offset);
+					input.length -= input.offset;
+					input.offset = 0;
+				}
+
+				if(input.buffer.size() - input.length < 4096) {
+					input.buffer.resize(std::max(input.buffer.size() * 2, (size_t) 16384));
+				}
+
+			}
+
+			ssize_t bytes = recv(values.fd, input.buffer.data() + input.length, input.buffer.size() - input.length, MSG_DONTWAIT);
+
+			if(bytes < 0) {
+
+				if(errno == EINTR) {
+					continue;
+				}
+
+				if(errno == EAGAIN || errno == EWOULDBLOCK) {
+					break;
+				}
+
+				int error = errno;
+				close();
+				handle_error(error);
+				return false;
+
+			}
+
+			if(bytes == 0) {
+
+				// Connection closed, deliver the pending data first.
+				if(received) {
+					handle_read_ok();
+				}
+
+				if(values.fd != -1) {
+					close();
+					handle_disconnect();
+				}
+
+				return false;
+
+			}
+
+			input.length += bytes;
+			received = true;
+
+		}
+
+		if(!received) {
+			return true;
+		}
+
+		if(watchdog) {
+			watchdog->received();
+		}
+
+		update();
+		handle_read_ok();
+
+		return values.fd != -1;
+
+	}
+
+	bool Socket::send() {
+
+		bool resume = false;
+		int error = 0;
+
+		{
+			lock_guard<recursive_mutex> lock(guard);
+
+			while(!output.queue.empty()) {
+
+				struct iovec iov[MAX_IOV];
+				size_t count = 0;
+				size_t length = 0;
+
+				for(const Buffer &buffer : output.queue) {
+					if(count >= MAX_IOV) {
+						break;
+					}
+					iov[count].iov_base = (void *) (buffer.data->data() + buffer.offset);
+					iov[count].iov_len = buffer.data->size() - buffer.offset;
+					length += iov[count].iov_len;
+					count++;
+				}
+
+				struct msghdr msg;
+				memset(&msg,0,sizeof(msg));
+				msg.msg_iov = iov;
+				msg.msg_iovlen = count;
+
+				ssize_t bytes = sendmsg(values.fd, &msg, MSG_DONTWAIT|MSG_NOSIGNAL);
+
+				if(bytes < 0) {
+
+					if(errno == EINTR) {
+						continue;
+					}
+
+					if(errno == EAGAIN || errno == EWOULDBLOCK) {
+						break;
+					}
+
+					error = errno;
+					break;
+
+				}
+
+				output.length -= bytes;
+
+				// Release the buffers already sent.
+				size_t sent = (size_t) bytes;
+				while(sent) {
+					Buffer &buffer = output.queue.front();
+					size_t remaining = buffer.data->size() - buffer.offset;
+					if(sent < remaining) {
+						buffer.offset += sent;
+						break;
+					}
+					sent -= remaining;
+					output.queue.pop_front();
+				}
+
+				if(watchdog) {
+					watchdog->sent();
+				}
+
+				if((size_t) bytes < length) {
+					// Partial write, the socket buffer is full.
+					break;
+				}
+
+			}
+
+			if(!error) {
+
+				if(output.paused && output.length <= output.watermarks.low) {
+					output.paused = false;
+					resume = true;
+				}
+
+				update();
+
+			}
+		}
+
+		// The handlers run unlocked, they can queue more data.
+		if(error) {
+			close();
+			handle_error(error);
+			return false;
+		}
+
+		if(resume) {
+			handle_write_ok();
+		}
+
+		return values.fd != -1;
+
+	}
+
+	bool Socket::write(const std::shared_ptr<const std::string> &data) {
+
+		if(values.fd == -1) {
+			throw system_error(ENOTCONN,system_category(),"Socket is not connected");
+		}
+
+		if(data && !data->empty()) {
+
+			bool flush;
+			{
+				lock_guard<recursive_mutex> lock(guard);
+				output.queue.push_back(Buffer{data,0});
+				output.length += data->size();
+
+				// Nothing was waiting, flush it; if connecting it will be sent after connection.
+				flush = (!connecting && output.queue.size() == 1);
+			}
+
+			if(flush) {
+
+				// The caller could be a worker thread, the handler is only changed (or closed) by the main loop.
+				MainLoop::getInstance().post<std::weak_ptr<Socket *>>(self,[](std::weak_ptr<Socket *> &reference){
+					auto socket = reference.lock();
+					if(socket && *socket && (*socket)->values.fd != -1) {
+						(*socket)->send();
+					}
+				});
+
+			}
+
+		}
+
+		bool pause = false;
+		bool paused;
+		{
+			lock_guard<recursive_mutex> lock(guard);
+			if(output.watermarks.high && !output.paused && output.length >= output.watermarks.high) {
+				output.paused = pause = true;
+			}
+			paused = output.paused;
+		}
+
+		if(pause) {
+			handle_write_paused();
+		}
+
+		return !paused;
+
+	}
+
+	size_t Socket::pending() const noexcept {
+		lock_guard<recursive_mutex> lock(guard);
+		return output.length;
+	}
+
+	bool Socket::paused() const noexcept {
+		lock_guard<recursive_mutex> lock(guard);
+		return output.paused;
+	}
+
+	bool Socket::write(const void *data, size_t length) {
+		return write(std::make_shared<const std::string>((const char *) data,length));
+	}
+
+	void Socket::set(const Watermarks &watermarks) {
+
+		if(watermarks.high && watermarks.low > watermarks.high) {
+			throw system_error(EINVAL,system_category(),"The low watermark is above the high watermark");
+		}
+
+		bool resume = false;
+		{
+			lock_guard<recursive_mutex> lock(guard);
+			output.watermarks = watermarks;
+			if(output.paused && (!watermarks.high || output.length <= watermarks.low)) {
+				output.paused = false;
+				resume = true;
+			}
+		}
+
+		if(resume) {
+			handle_write_ok();
+		}
+
+	}
+
+	void Socket::set(const Timeouts &timeouts) {
+
+		if(!watchdog) {
+			watchdog = new Watchdog(*this);
+		}
+
+		watchdog->timeouts = timeouts;
+		watchdog->started = watchdog->activity = MainLoop::Timer::getCurrentTime();
+		watchdog->waiting = 0;
+
+		// Check at a quarter of the shortest timeout, between 100ms and 1s.
+		unsigned long interval = 0;
+		for(unsigned long value : { timeouts.connect, timeouts.read, timeouts.idle }) {
+			if(value && (!interval || value < interval)) {
+				interval = value;
+			}
+		}
+
+		if(!interval || values.fd == -1) {
+			watchdog->disable();
+			return;
+		}
+
+		watchdog->enable(std::min(std::max(interval/4, 100UL), 1000UL));
+
+	}
+
+	void Socket::consume(size_t length) noexcept {
+
+		input.offset += std::min(length,available());
+
+		if(input.offset == input.length) {
+			input.offset = input.length = 0;
+		}
+
+		if(values.fd != -1 && !connecting && !(values.events & MainLoop::Handler::oninput)) {
+			// Reading was stopped by the input limit.
+			update();
+		}
+
+	}
+
+	bool Socket::read(std::string &frame, const char *delimiter) {
+
+		size_t length = strlen(delimiter);
+		if(!length) {
+			throw system_error(EINVAL,system_category(),"Invalid frame delimiter");
+		}
+
+		const char *begin = data();
+		const char *end = begin + available();
+		const char *found = std::search(begin,end,delimiter,delimiter+length);
+
+		if(found == end) {
+			if(available() >= input.limit) {
+				// Reading is stopped by the limit, the delimiter will never arrive.
+				throw system_error(EMSGSIZE,system_category(),"Frame is larger than the input buffer limit");
+			}
+			return false;
+		}
+
+		frame.assign(begin,found - begin);
+		consume((found - begin) + length);
+
+		return true;
+
+	}
+
+	bool Socket::read(std::string &frame, size_t prefix) {
+
+		if(prefix != 1 && prefix != 2 && prefix != 4) {
+			throw system_error(EINVAL,system_category(),"Invalid frame prefix size");
+		}
+
+		if(available() < prefix) {
+			return false;
+		}
+
+		const uint8_t *ptr = (const uint8_t *) data();
+		size_t length = 0;
+		for(size_t ix = 0; ix < prefix; ix++) {
+			length = (length << 8) | ptr[ix];
+		}
+
+		if(prefix + length > input.limit) {
+			throw system_error(EMSGSIZE,system_category(),"Frame is larger than the input buffer limit");
+		}
+
+		if(available() < prefix + length) {
+			return false;
+		}
+
+		frame.assign(data() + prefix,length);
+		consume(prefix + length);
+
+		return true;
+
+	}
+
 	void Socket::handle_connect(int error) {
 	}
 
@@ -364,8 +846,16 @@
 	void Socket::handle_write_ok() {
 	}
 
+	void Socket::handle_write_paused() {
+	}
+
 	void Socket::handle_error(int) {
 	}
 
+	void Socket::handle_timeout() {
+		close();
+		handle_error(ETIMEDOUT);
+	}
+
  }
 
@@ -36,31 +36,62 @@
  #include <udjat/tools/handler.h>
  #include <iostream>
  #include <cstring>
- #include <csignal>
  #include <sys/wait.h>
  #include <sys/poll.h>
  #include <udjat/tools/threadpool.h>
  #include <udjat/tools/logger.h>
+ #include <vector>
 
  namespace Udjat {
 
 	SubProcess::Controller::Controller() {
-		signal(SIGCHLD,handle_signal);
 	}
 
 	SubProcess::Controller::~Controller() {
-		signal(SIGCHLD,SIG_DFL);
 	}
 
-	void SubProcess::Controller::handle_signal(int UDJAT_UNUSED(sig)) noexcept {
+	void SubProcess::Controller::push_back(Entry &entry) {
 
-		int status = 0;
-		pid_t pid = waitpid(0,&status,WNOHANG);
+		entry.watcher = Watcher::factory(entry.proc->pid);
 
-		ThreadPool::getInstance().push("SubProcCleanup",[pid,status](){
-			getInstance().child_ended(pid,status);
+		entries.push_back(entry);
+
+		if(entry.watcher) {
+			// Enable only after inserting the entry, the child can end at any time.
+			entry.watcher->enable();
+		} else if(!MainLoop::Timer::enabled()) {
+			MainLoop::Timer::enable(100);
+		}
+
+	}
+
+	void SubProcess::Controller::on_timer() {
+
+		// No pidfd, check the children without watcher.
+		// Copy the pids under the container lock (remove_if is the locked walk for value entries),
+		// child_ended() removes entries from the thread pool.
+		std::vector<pid_t> pids;
+		entries.remove_if([&pids](const Entry &entry){
+			if(!entry.watcher && entry.proc->pid != -1) {
+				pids.push_back(entry.proc->pid);
+			}
+			return false;
 		});
 
+		if(pids.empty()) {
+			MainLoop::Timer::disable();
+			return;
+		}
+
+		for(pid_t pid : pids) {
+			int status = 0;
+			if(waitpid(pid,&status,WNOHANG) == pid) {
+				ThreadPool::getInstance().push("SubProcCleanup",[pid,status](){
+					getInstance().child_ended(pid,status);
+				});
+			}
+		}
+
 	}
 
 	void SubProcess::Controller::child_ended(pid_t pid, int status) noexcept {
@@ -91,9 +122,7 @@
 			entry.out->disable();
 			entry.err->disable();
 
-			usleep(100);
-
-			// check for pending events.
+			// The child is gone, read what's left on the pipes.
 			{
 				MainLoop::Handler *hdl[]{entry.out.get(),entry.err.get()};
 				Handler::flush(hdl,2,1000);
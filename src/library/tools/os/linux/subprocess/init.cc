@@ -102,15 +102,9 @@
 			logmsg.trace(proc.name());
 		}
 
-		// Fork new proccess
-		sigset_t mask, omask;
-		sigemptyset(&mask);
-		sigaddset(&mask, SIGCHLD);
-		sigprocmask(SIG_BLOCK, &mask, &omask);
-
+		// Fork new proccess; no SIGCHLD handler, the child is reaped by the controller or by run().
 		switch (proc.pid = vfork()) {
 		case -1: // Error
-			sigprocmask(SIG_SETMASK, &omask, NULL);
 			errcode = errno;
 			::close(out[0]);
 			::close(out[1]);
@@ -120,7 +114,6 @@
 
 		case 0:	// child
 
-			sigprocmask(SIG_SETMASK, &omask, NULL);
 			if(out[1] != STDOUT_FILENO) {
 				(void)dup2(out[1], STDOUT_FILENO);
 				(void)close(out[1]);
@@ -149,12 +142,18 @@
 
 			}
 
+			// The parent can block signals (see MainLoop), don't let the child inherit the mask.
+			{
+				sigset_t mask;
+				sigemptyset(&mask);
+				sigprocmask(SIG_SETMASK, &mask, NULL);
+			}
+
 			execvp(*argv,argv);
 			_exit(127);
 
 		}
 
-		sigprocmask(SIG_SETMASK, &omask, NULL);
 		free(buffer);
 
 		// Child started, capture pipes.
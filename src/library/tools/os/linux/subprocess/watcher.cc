@@ -0,0 +1,93 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2021 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /***
+  * @brief Implement the pidfd based child watcher.
+  *
+  * References:
+  *
+  * <https://man7.org/linux/man-pages/man2/pidfd_open.2.html>
+  *
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <private/linux/subprocess.h>
+ #include <sys/types.h>
+ #include <sys/syscall.h>
+ #include <sys/wait.h>
+ #include <unistd.h>
+ #include <udjat/tools/mainloop.h>
+ #include <udjat/tools/handler.h>
+ #include <udjat/tools/threadpool.h>
+ #include <udjat/tools/logger.h>
+ #include <cstring>
+
+ namespace Udjat {
+
+	std::shared_ptr<SubProcess::Controller::Watcher> SubProcess::Controller::Watcher::factory(pid_t pid) {
+
+#ifdef SYS_pidfd_open
+		// The child can't be reaped by anyone else, so the pid is still valid here even if it has already ended.
+		int fd = (int) syscall(SYS_pidfd_open, pid, 0);
+		if(fd >= 0) {
+			return make_shared<Watcher>(pid,fd);
+		}
+
+		if(errno != ENOSYS) {
+			Logger::String{"Can't open pidfd for ",pid,": ",strerror(errno)}.warning("subprocess");
+		}
+#endif // SYS_pidfd_open
+
+		return std::shared_ptr<Watcher>();
+
+	}
+
+	SubProcess::Controller::Watcher::Watcher(pid_t p, int fd) : MainLoop::Handler{fd,oninput}, pid{p} {
+	}
+
+	SubProcess::Controller::Watcher::~Watcher() {
+		close();
+	}
+
+	void SubProcess::Controller::Watcher::handle_event(const Event) {
+
+		// The pidfd is readable when the child ends.
+		int status = 0;
+		pid_t rc = waitpid(pid,&status,WNOHANG);
+
+		if(rc == 0) {
+			return;
+		}
+
+		disable();
+
+		if(rc != pid) {
+			Logger::String{"Can't get status of pid ",pid,": ",strerror(errno)}.error("subprocess");
+			status = 0;
+		}
+
+		pid_t child = pid;
+		ThreadPool::getInstance().push("SubProcCleanup",[child,status](){
+			getInstance().child_ended(child,status);
+		});
+
+	}
+
+ }
@@ -94,8 +94,8 @@
 
 	void File::Watcher::Controller::watch_directory(File::Watcher *watcher) {
 
-		add_watch(watcher,watcher->pathname,FALSE,FILE_NOTIFY_CHANGE_FILE_NAME);
-		add_watch(watcher,watcher->pathname,FALSE,FILE_NOTIFY_CHANGE_DIR_NAME);
+		add_watch(watcher,watcher->pathname,(watcher->recursive ? TRUE : FALSE),FILE_NOTIFY_CHANGE_FILE_NAME);
+		add_watch(watcher,watcher->pathname,(watcher->recursive ? TRUE : FALSE),FILE_NOTIFY_CHANGE_DIR_NAME);
 
 	}
 
@@ -26,6 +26,7 @@
 #include <mutex>
 #include <unordered_set>
 #include <udjat/tools/quark.h>
+#include <private/xml.h>
 
 #ifdef DEBUG
 	#undef DEBUG // Disable debug messages
@@ -265,13 +266,10 @@ namespace Udjat {
 		}
 
 		// Check children for <attribute name=>
-		for(XML::Node child = node.child("attribute"); child; child = child.next_sibling("attribute")) {
-
-			if(strcasecmp(xml_attribute,child.attribute("name").as_string()) == 0) {
-				set(child.attribute("value").as_string(),translate);
-				return *this;
-			}
-
+		XML::Node child{XML::Index::attribute(node,xml_attribute,false)};
+		if(child) {
+			set(child.attribute("value").as_string(),translate);
+			return *this;
 		}
 
 		// If upsearch is true repeat the query on parent node.
@@ -296,13 +294,10 @@ namespace Udjat {
 		}
 
 		// Check children for <attribute name=>
-		for(XML::Node child = node.child("attribute"); child; child = child.next_sibling("attribute")) {
-
-			if(strcasecmp(xml_attribute,child.attribute("name").as_string()) == 0) {
-				set(child.attribute("value").as_string());
-				return *this;
-			}
-
+		XML::Node child{XML::Index::attribute(node,xml_attribute,false)};
+		if(child) {
+			set(child.attribute("value").as_string());
+			return *this;
 		}
 
 		// If upsearch is true repeat the query on parent node.
@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements the factory registry statistics.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/logger.h>
+ #include <private/registry.h>
+ #include <mutex>
+ #include <list>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	static mutex guard;
+
+	static list<Abstract::Registry *> & Registries() {
+		static list<Abstract::Registry *> instance;
+		return instance;
+	}
+
+	Abstract::Registry::Registry(const char *name) : registry_name{name} {
+		lock_guard<mutex> lock(guard);
+		Registries().push_back(this);
+	}
+
+	Abstract::Registry::~Registry() {
+		lock_guard<mutex> lock(guard);
+		Registries().remove(this);
+	}
+
+	void Abstract::Registry::trace() noexcept {
+
+		if(!Logger::enabled(Logger::Trace)) {
+			return;
+		}
+
+		lock_guard<mutex> lock(guard);
+		for(const auto registry : Registries()) {
+			try {
+				registry->statistics([registry](const char *name, size_t count){
+					if(count) {
+						Logger::String{"Factory <",name,"> handled ",count," node(s)"}.trace(registry->name());
+					}
+				});
+			} catch(const std::exception &e) {
+				Logger::String{e.what()}.error(registry->name());
+			}
+		}
+
+	}
+
+ }
@@ -22,7 +22,9 @@
  #include <udjat/tools/report.h>
  #include <udjat/tools/value.h>
  #include <udjat/tools/intl.h>
+ #include <private/cbor.h>
  #include <cstdarg>
+ #include <cstring>
  #include <stdexcept>
  #include <iomanip>
  #include <system_error>
@@ -39,18 +41,23 @@
 	}
 
 	Report::Report(const Udjat::Value &first_row) {
-		first_row.for_each([&](const char *name, const Value &value){
-			headers.emplace_back(name);
-			auto cell = cells.emplace_back();
-			cell.set(value);
+
+		first_row.for_each([&](const char *name, const Value &){
+			table.emplace_back(name);
+			return false;
+		});
+
+		first_row.for_each([&](const char *, const Value &value){
+			store(value);
 			return false;
 		});
 
 	}
 
 	Report::Report(const std::vector<string> &names) {
+		table.reserve(names.size());
 		for(const auto &name : names) {
-			headers.emplace_back(name);
+			table.emplace_back(name.c_str());
 		}
 	}
 
@@ -58,45 +65,70 @@
 	}
 
 	void Report::set_headers(const char *column_name, va_list args) {
-		if(!headers.empty()) {
+		if(!table.empty()) {
 			throw system_error(EBUSY,system_category(),"Report already started");
 		}
 		while(column_name) {
-			headers.emplace_back(column_name);
+			table.emplace_back(column_name);
 			column_name = va_arg(args, const char *);
 		}
 	}
 
-	Report::Cell::Cell() {
+	size_t Report::rows() const noexcept {
+		if(table.empty()) {
+			return 0;
+		}
+		return (cells + table.size() - 1) / table.size();
+	}
+
+	void Report::reserve(size_t rows, size_t length) {
+		for(Column &column : table) {
+			column.types.reserve(rows);
+			column.data.reserve(rows);
+		}
+		strings.reserve(rows * length);
 	}
 
-	Report::Cell::~Cell() {
-		clear();
+	Report::Column & Report::next() {
+		if(table.empty()) {
+			throw logic_error("Report has no columns");
+		}
+		return table[cells % table.size()];
+	}
+
+	void Report::check_row(size_t length) const {
+		if(length != table.size()) {
+			throw system_error(EINVAL,system_category(),"The row length doesn't match the report columns");
+		}
+		if(cells % table.size()) {
+			throw system_error(EINVAL,system_category(),"Cant append a row after an incomplete one");
+		}
+	}
+
+	void Report::store(Value::Type type, Data data) {
+		Column &column = next();
+		column.types.push_back(type);
+		column.data.push_back(data);
+		cells++;
 	}
 
 	Report & Report::push_back(const Value &value) {
 		if(value == Value::Object) {
-			for(const auto &name : headers) {
-				cells.emplace_back().set(value[name.c_str()]);			
+			for(const auto &column : table) {
+				store(value[column.name.c_str()]);
 			}
 		} else {
-			cells.emplace_back().set(value);			
+			store(value);
 		}
 		return *this;
 	}
 
-	void Report::Cell::clear() noexcept {
-		if(data.ptr) {
-			if(type == Value::String || type == Value::Url || type == Value::Icon) {
-				free(data.ptr);
-			}
-			data.ptr = nullptr;
-		}
-	}
+	void Report::store(const Value &value) {
 
-	void Report::Cell::set(const Value &value) {
-		clear();
-		type = (Value::Type) value;
+		Data data;
+		data.unsig = 0;
+
+		Value::Type type = (Value::Type) value;
 		switch(type) {
 		case Value::Undefined:
 			break;
@@ -104,7 +136,9 @@
 		case Value::String:
 		case Value::Icon:
 		case Value::Url:
-			data.ptr = strdup(value.c_str());
+			data.offset = strings.size();
+			strings.append(value.c_str());
+			strings.push_back(0);
 			break;
 
 		case Value::Timestamp:
@@ -117,12 +151,20 @@
 
 		case Value::State:
 		case Value::Signed:
-			value.get(data.sig);
+			{
+				long sig = 0;
+				value.get(sig);
+				data.sig = sig;
+			}
 			break;
 
 		case Value::Unsigned:
 		case Value::Boolean:
-			value.get(data.unsig);
+			{
+				unsigned long unsig = 0;
+				value.get(unsig);
+				data.unsig = unsig;
+			}
 			break;
 
 		case Value::Real:
@@ -135,78 +177,88 @@
 
 		}
 
+		store(type,data);
+
 	}
 
-	void Report::Cell::set(const char *value) {
-		clear();
-		type = Value::String;
-		data.ptr = strdup(value);
+	void Report::store(const char *value) {
+		Data data;
+		data.offset = strings.size();
+		strings.append(value);
+		strings.push_back(0);
+		store(Value::String,data);
 	}
 
-	void Report::Cell::set(const short value) {
-		clear();
-		type = Value::Signed;
-		data.sig = value;
+	void Report::store(const short value) {
+		store((long long) value);
 	}
 
-	void Report::Cell::set(const unsigned short value) {
-		clear();
-		type = Value::Unsigned;
-		data.unsig = value;
+	void Report::store(const unsigned short value) {
+		store((unsigned long long) value);
 	}
 
-	void Report::Cell::set(const int value) {
-		clear();
-		type = Value::Signed;
-		data.sig = value;		
+	void Report::store(const int value) {
+		store((long long) value);
 	}
 
-	void Report::Cell::set(const unsigned int value) {
-		clear();
-		type = Value::Unsigned;
+	void Report::store(const unsigned int value) {
+		store((unsigned long long) value);
+	}
+
+	void Report::store(const long value) {
+		store((long long) value);
+	}
+
+	void Report::store(const unsigned long value) {
+		store((unsigned long long) value);
+	}
+
+	void Report::store(const long long value) {
+		Data data;
+		data.sig = value;
+		store(Value::Signed,data);
+	}
+
+	void Report::store(const unsigned long long value) {
+		Data data;
 		data.unsig = value;
+		store(Value::Unsigned,data);
 	}
 
-	void Report::Cell::set(const TimeStamp &value) {
-		clear();
-		type = Value::Timestamp;
-		data.timestamp = (time_t) value;		
+	void Report::store(const TimeStamp &value) {
+		Data data;
+		data.timestamp = (time_t) value;
+		store(Value::Timestamp,data);
 	}
 
-	void Report::Cell::set(const bool value) {
-		clear();
-		type = Value::Boolean;
+	void Report::store(const bool value) {
+		Data data;
 		data.unsig = value;
+		store(Value::Boolean,data);
 	}
 
-	void Report::Cell::set(const float value) {
-		clear();
-		type = Value::Real;
-		data.dbl = value;
+	void Report::store(const float value) {
+		store((double) value);
 	}
 
-	void Report::Cell::set(const double value) {
-		clear();
-		type = Value::Real;
+	void Report::store(const double value) {
+		Data data;
 		data.dbl = value;
+		store(Value::Real,data);
 	}
 
-	void Report::Cell::serialize(std::ostream &out) const {
+	void Report::write(std::ostream &out, const Column &column, size_t row) const {
 
-		switch(type) {
-		case Value::Undefined:
-			break;
+		const Data &data = column.data[row];
 
-		case Value::Array:
-		case Value::Object:
-		case Value::Report:
-			throw logic_error("Unable to convert value");
+		switch(column.types[row]) {
+		case Value::Undefined:
 			break;
 
 		case Value::Icon:
 		case Value::Url:
 		case Value::String:
-			out << ((const char *) data.ptr);
+			out << (strings.c_str() + data.offset);
 			break;
 
 		case Value::Timestamp:
@@ -214,15 +266,15 @@
 			break;
 
 		case Value::Signed:
+		case Value::State:
 			out << data.sig;
 			break;
 
 		case Value::Boolean:
-			out << (data.sig ? _("Yes") : _("No"));
+			out << (data.unsig ? _("Yes") : _("No"));
 			break;
 
 		case Value::Unsigned:
-		case Value::State:
 			out << data.unsig;
 			break;
 
@@ -244,39 +296,44 @@
 
 		out << "[";
 
-		if(!cells.empty()) {
+		size_t rows = this->rows();
+		for(size_t row = 0; row < rows; row++) {
 
-			out << "{";
-			bool sep = false;
-			auto column = headers.begin();
-			for(const auto &cell : cells ) {
+			out << (row ? ",{" : "{");
 
-				if(column == headers.end()) {
-					out << "},{";
-					sep = false;
-					column = headers.begin();
+			for(const Column &column : table) {
+
+				if(row >= column.size()) {
+					break;
 				}
 
-				if(sep) {
+				if(&column != &table.front()) {
 					out << ',';
 				}
-				sep = true;
 
-				out << "\"" << *column << "\":";
+				out << "\"" << column.name << "\":";
 
-				if(cell.type == Value::String || cell.type == Value::Url || cell.type == Value::Icon || cell.type == Value::Timestamp) {
+				switch(column.types[row]) {
+				case Value::String:
+				case Value::Url:
+				case Value::Icon:
+				case Value::Timestamp:
 					out << "\"";
-					cell.serialize(out);
+					write(out,column,row);
 					out << "\"";
-				} else if(cell.type == Value::Undefined) {
+					break;
+
+				case Value::Undefined:
 					out << "false";
-				} else if(cell.type == Value::Boolean) {
-					out << (cell.data.sig ? "true" : "false");
-				} else {
-					cell.serialize(out);
-				}
+					break;
+
+				case Value::Boolean:
+					out << (column.data[row].unsig ? "true" : "false");
+					break;
 
-				column++;
+				default:
+					write(out,column,row);
+				}
 
 			}
 
@@ -293,23 +350,21 @@
 			out << "<caption>" << field.caption << "</caption>";
 		}
 
-		if(!cells.empty()) {
-
-			auto column = headers.begin();
+		size_t rows = this->rows();
+		for(size_t row = 0; row < rows; row++) {
 
 			out << "<item>";
-			for(const auto &cell : cells ) {
 
-				if(column == headers.end()) {
-					out << "</item><item>";
-					column = headers.begin();
+			for(const Column &column : table) {
+
+				if(row >= column.size()) {
+					break;
 				}
 
-				out << "<" << *column << ">";
-				cell.serialize(out);
-				out << "</" << *column << ">";
+				out << "<" << column.name << ">";
+				write(out,column,row);
+				out << "</" << column.name << ">";
 
-				column++;
 			}
 
 			out << "</item>";
@@ -325,56 +380,201 @@
 		}
 		out << "<thead><tr>";
 
-		for(const auto &header : headers) {
-			out << "<th>" << header << "</th>";
+		for(const Column &column : table) {
+			out << "<th>" << column.name << "</th>";
 		}
 
 		out << "</tr></thead>";
 		
-		if(cells.empty()) {
+		if(empty()) {
 			out << "<tbody class=\"no-data\" />";
 		} else {
 			out << "<tbody>";
 
-			auto column = headers.begin();
+			size_t rows = this->rows();
+			for(size_t row = 0; row < rows; row++) {
+
+				out << "<tr>";
+
+				for(const Column &column : table) {
+
+					if(row >= column.size()) {
+						break;
+					}
+
+					if(column.types[row] == Value::Boolean) {
+						out << "<td class=\"" << (column.data[row].unsig ? "true-value" : "false-value") << "\">";
+					} else {
+						out << "<td class=\"" << std::to_string(column.types[row]) << "\">";
+					}
 
-			out << "<tr>";
-			for(const auto &cell : cells ) {
+					write(out,column,row);
+					out << "</td>";
 
-				if(column == headers.end()) {
-					out <<  "</tr><tr>";
-					column = headers.begin();
 				}
 
-				if(cell.type == Value::Boolean) {
-					out << "<td class=\"" << (cell.data.sig ? "true-value" : "false-value") << "\">";
-				} else {
-					out << "<td class=\"" << std::to_string(cell.type) << "\">";
+				out << "</tr>";
+			}
+
+			out << "</tbody>";
+		}
+
+		out << "</table>";
+	}
+
+	void Report::to_cbor(std::ostream &out) const {
+
+		// Tagged array, the column names followed by the rows.
+		size_t rows = this->rows();
+
+		CBOR::head(out,CBOR::Tag,CBOR::UdjatTag(Value::Report));
+		CBOR::head(out,CBOR::Array,rows+1);
+
+		CBOR::head(out,CBOR::Array,table.size());
+		for(const Column &column : table) {
+			CBOR::text(out,column.name.c_str());
+		}
+
+		for(size_t row = 0; row < rows; row++) {
+
+			size_t length = 0;
+			for(const Column &column : table) {
+				if(row < column.size()) {
+					length++;
 				}
+			}
+
+			CBOR::head(out,CBOR::Array,length);
+
+			for(size_t ix = 0; ix < length; ix++) {
+
+				const Data &data = table[ix].data[row];
+
+				switch(table[ix].types[row]) {
+				case Value::Undefined:
+					CBOR::null(out);
+					break;
+
+				case Value::Icon:
+					CBOR::head(out,CBOR::Tag,CBOR::UdjatTag(Value::Icon));
+					CBOR::text(out,strings.c_str() + data.offset);
+					break;
+
+				case Value::Url:
+					CBOR::head(out,CBOR::Tag,32);
+					CBOR::text(out,strings.c_str() + data.offset);
+					break;
+
+				case Value::String:
+					CBOR::text(out,strings.c_str() + data.offset);
+					break;
+
+				case Value::Timestamp:
+					CBOR::head(out,CBOR::Tag,1);
+					CBOR::integer(out,(long long) data.timestamp,false);
+					break;
+
+				case Value::Signed:
+					CBOR::integer(out,data.sig,true);
+					break;
+
+				case Value::State:
+					CBOR::head(out,CBOR::Tag,CBOR::UdjatTag(Value::State));
+					CBOR::integer(out,data.sig,false);
+					break;
+
+				case Value::Boolean:
+					CBOR::boolean(out,data.unsig != 0);
+					break;
+
+				case Value::Unsigned:
+					CBOR::head(out,CBOR::Positive,data.unsig);
+					break;
+
+				case Value::Real:
+					CBOR::real(out,data.dbl);
+					break;
 
-				cell.serialize(out);
-				out << "</td>";
+				case Value::Fraction:
+					CBOR::head(out,CBOR::Tag,CBOR::UdjatTag(Value::Fraction));
+					CBOR::real(out,data.dbl);
+					break;
+
+				default:
+					throw logic_error("The column type is unexpected or invalid");
+				}
 
-				column++;
 			}
 
-			out << "</tr></tbody>";
 		}
 
-		out << "</table>";
 	}
 
-	void Report::to_yaml(std::ostream &out, size_t left_margin) const {
+	void Report::to_yaml(std::ostream &, size_t) const {
 
 	}
 
-	void Report::to_sh(std::ostream &stream) const {
+	void Report::to_sh(std::ostream &) const {
 
 	}
 
 	void Report::to_csv(std::ostream &out, char delimiter) const {
 
-	}
+		for(const Column &column : table) {
+			if(&column != &table.front()) {
+				out << delimiter;
+			}
+			out << "\"" << column.name << "\"";
+		}
+		out << "\r\n";
+
+		size_t rows = this->rows();
+		for(size_t row = 0; row < rows; row++) {
+
+			for(const Column &column : table) {
+
+				if(row >= column.size()) {
+					break;
+				}
+
+				if(&column != &table.front()) {
+					out << delimiter;
+				}
+
+				switch(column.types[row]) {
+				case Value::String:
+				case Value::Url:
+				case Value::Icon:
+					// Quote and double the embedded quotes (RFC 4180).
+					out << "\"";
+					for(const char *ptr = strings.c_str() + column.data[row].offset; *ptr; ptr++) {
+						if(*ptr == '"') {
+							out << '"';
+						}
+						out << *ptr;
+					}
+					out << "\"";
+					break;
 
+				case Value::Timestamp:
+					out << "\"";
+					write(out,column,row);
+					out << "\"";
+					break;
+
+				case Value::Boolean:
+					out << (column.data[row].unsig ? "1" : "0");
+					break;
+
+				default:
+					write(out,column,row);
+				}
+
+			}
+
+			out << "\r\n";
+		}
+
+	}
 
  }
@@ -26,6 +26,7 @@
  #include <udjat/tools/xml.h>
  #include <udjat/tools/application.h>
  #include <udjat/tools/object.h>
+ #include <private/xml.h>
 
  #ifdef _WIN32
 	#include <private/win32.h>
@@ -115,19 +116,12 @@
 		},dynamic,cleanup);
 	}
 
-	static bool check_node(XML::Node &xml, const char *key, std::string &value) {
+	static bool check_node(const XML::Node &xml, const char *key, std::string &value) {
 
-		for(auto child = xml.child("attribute"); child; child = child.next_sibling("attribute")) {
-
-			// Check the attribute name.
-			if(!strcasecmp(key,child.attribute("name").as_string("*"))) {
-
-				if(is_allowed(child)) {
-					value = child.attribute("value").as_string();
-					return true;
-				}
-
-			}
+		XML::Node child{XML::Index::attribute(xml,key,true)};
+		if(child) {
+			value = child.attribute("value").as_string();
+			return true;
 		}
 
 		return false;
@@ -173,12 +167,10 @@
 					}
 
 					// Search attribute lists.
-					for(auto lst = xml.child("attribute-list"); lst; lst = lst.next_sibling("attribute-list")) {
-
-						if(is_allowed(lst) && check_node(lst,key,value)) {
-							return true;
-						}
-
+					if(XML::Index::for_each(xml,"attribute-list",[key,&value](const XML::Node &lst){
+						return is_allowed(lst) && check_node(lst,key,value);
+					})) {
+						return true;
 					}
 
 				}
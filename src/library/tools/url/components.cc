@@ -0,0 +1,125 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements the parsed URL components.
+  */
+
+ #include <config.h>
+ #include <udjat/tools/url.h>
+ #include <udjat/tools/logger.h>
+ #include <uriparser/Uri.h>
+ #include <private/urlparser.h>
+ #include <memory>
+ #include <string>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	URL::Components::Components(const std::string &url) : text{url} {
+
+		if(text.empty()) {
+			return;
+		}
+
+		ParsedUri uri{text};
+
+		// The parser ranges point to our copy of the URL, store them as offsets.
+		const char *base = text.c_str();
+		auto span = [base](const UriTextRangeA &range) {
+			Span rc;
+			if(range.first) {
+				rc.offset = (size_t) (range.first - base);
+				rc.length = (size_t) (range.afterLast - range.first);
+			}
+			return rc;
+		};
+
+		spans[Scheme] = span(uri.scheme);
+		spans[Host] = span(uri.hostText);
+		spans[Port] = span(uri.portText);
+		spans[Query] = span(uri.query);
+		spans[Fragment] = span(uri.fragment);
+
+		for(UriPathSegmentA *segment = uri.pathHead; segment; segment = segment->next) {
+			paths.push_back(span(segment->text));
+		}
+
+	}
+
+	std::string_view URL::Components::view(const Span &span) const noexcept {
+		if(span.offset == std::string::npos) {
+			return std::string_view{};
+		}
+		return std::string_view{text.c_str()+span.offset,span.length};
+	}
+
+	std::string_view URL::Components::scheme() const noexcept {
+		return view(spans[Scheme]);
+	}
+
+	std::string_view URL::Components::hostname() const noexcept {
+		return view(spans[Host]);
+	}
+
+	std::string_view URL::Components::port() const noexcept {
+		return view(spans[Port]);
+	}
+
+	std::string_view URL::Components::query() const noexcept {
+		return view(spans[Query]);
+	}
+
+	std::string_view URL::Components::fragment() const noexcept {
+		return view(spans[Fragment]);
+	}
+
+	std::string_view URL::Components::segment(size_t index) const noexcept {
+		if(index >= paths.size()) {
+			return std::string_view{};
+		}
+		return view(paths[index]);
+	}
+
+	std::string URL::Components::path() const {
+		std::string rc;
+		for(const Span &span : paths) {
+			rc += '/';
+			rc.append(text,span.offset,span.length);
+		}
+		return rc;
+	}
+
+	std::shared_ptr<const URL::Components> URL::components() const {
+
+		auto cached = std::atomic_load(&parsed);
+		if(cached && *cached == *this) {
+			return cached;
+		}
+
+		// Not parsed or changed by the std::string methods, parse again.
+		cached = std::make_shared<const Components>(*this);
+		std::atomic_store(&parsed,cached);
+
+		return cached;
+
+	}
+
+ }
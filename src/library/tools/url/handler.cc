@@ -21,7 +21,6 @@
  #include <udjat/tools/url.h>
  #include <list>
 
- #include <sstream>
  #include <udjat/tools/file.h>
  #include <udjat/tools/file/handler.h>
  #include <udjat/tools/file/temporary.h>
@@ -32,15 +31,35 @@
  #include <private/url.h>
  #include <uriparser/Uri.h>
  #include <private/urlparser.h>
- #include <udjat/tools/container.h>
+ #include <udjat/tools/configuration.h>
+ #include <private/registry.h>
+ #include <unordered_map>
+ #include <vector>
+ #include <mutex>
 
  using namespace std;
 
  namespace  Udjat {
 
- 	Container<URL::Handler::Factory> & factories() {
-		static Container<URL::Handler::Factory> factories;
-		return factories;
+	/// @brief URL handler factories by scheme.
+	static Registry<URL::Handler::Factory> & Factories() {
+		static Registry<URL::Handler::Factory> instance{"url-handlers"};
+		return instance;
+	}
+
+	/// @brief Idle handlers of a factory.
+	struct HandlerPool {
+		std::mutex guard;
+		size_t size = 0;	///< @brief Number of idle handlers.
+		std::unordered_map<std::string,std::vector<std::shared_ptr<URL::Handler>>> idle;
+	};
+
+	static std::mutex pools_guard;
+
+	/// @brief Handler pools by factory, removed with the factory.
+	static std::unordered_map<const URL::Handler::Factory *,std::shared_ptr<HandlerPool>> & Pools() {
+		static std::unordered_map<const URL::Handler::Factory *,std::shared_ptr<HandlerPool>> instance;
+		return instance;
 	}
 
 	URL::Handler::Factory::Factory(const char *n, const char *description) : name{n} {
@@ -49,17 +68,105 @@
 		} else {
 			Logger::String{"Registering URL handler '",name,"'"}.trace();
 		}
-		factories().push_back(this);
+		Factories().insert(name,this);
+		pool_size = Config::Value<unsigned int>("url-handler-pool",name,0).get();
 	}
 
 	URL::Handler::Factory::~Factory() {
 		Logger::String{"Removing URL handler '",name,"'"}.write(Logger::Debug);
-		factories().remove(this);
+		Factories().remove(name,this);
+
+		// Drop the idle handlers, the module code can go away with the factory.
+		std::shared_ptr<HandlerPool> pool;
+		{
+			std::lock_guard<std::mutex> lock(pools_guard);
+			auto it = Pools().find(this);
+			if(it != Pools().end()) {
+				pool = it->second;
+				Pools().erase(it);
+			}
+		}
+
+		if(pool) {
+			std::lock_guard<std::mutex> lock(pool->guard);
+			pool->idle.clear();
+			pool->size = 0;
+		}
+
+	}
+
+	std::shared_ptr<URL::Handler> URL::Handler::Factory::handler(const URL &url) const {
+
+		if(!pool_size) {
+			return HandlerFactory(url);
+		}
+
+		std::shared_ptr<HandlerPool> pool;
+		{
+			std::lock_guard<std::mutex> lock(pools_guard);
+			auto &entry = Pools()[this];
+			if(!entry) {
+				entry = std::make_shared<HandlerPool>();
+			}
+			pool = entry;
+		}
+
+		std::shared_ptr<Handler> handler;
+		{
+			std::lock_guard<std::mutex> lock(pool->guard);
+			auto it = pool->idle.find(url);
+			if(it != pool->idle.end() && !it->second.empty()) {
+				handler = it->second.back();
+				it->second.pop_back();
+				pool->size--;
+				if(it->second.empty()) {
+					pool->idle.erase(it);
+				}
+			}
+		}
+
+		if(!handler) {
+			handler = HandlerFactory(url);
+		}
+
+		// The caller gets an alias, the handler goes back to the pool when it's released.
+		static const size_t max_idle = Config::Value<unsigned int>("url","max-idle-handlers",64).get();
+		std::weak_ptr<HandlerPool> wpool{pool};
+		size_t limit = pool_size;
+		std::string key{url};
+
+		return std::shared_ptr<Handler>(handler.get(),[handler,wpool,limit,key](Handler *) mutable {
+
+			auto pool = wpool.lock();
+			if(!pool) {
+				return;
+			}
+
+			try {
+				if(!handler->reset()) {
+					return;	// Can't clear its request state.
+				}
+			} catch(const std::exception &e) {
+				Logger::String{"Not reusing handler for ",key.c_str(),": ",e.what()}.trace();
+				return;
+			}
+
+			std::lock_guard<std::mutex> lock(pool->guard);
+			auto &idle = pool->idle[key];
+			if(idle.size() < limit && pool->size < max_idle) {
+				idle.push_back(std::move(handler));
+				pool->size++;
+			} else if(idle.empty()) {
+				pool->idle.erase(key);
+			}
+
+		});
+
 	}
 
 	std::shared_ptr<URL::Handler> URL::handler(bool allow_default, bool autoload) const {
 
-		auto scheme = this->scheme();
+		std::string scheme{components()->scheme()};
 		auto mark = scheme.find('+');
 
 		if(mark != string::npos) {
@@ -73,18 +180,18 @@
 				throw logic_error(Logger::String{"Circular reference on ",this->c_str()});
 			}
 
-			for(const auto factory : factories()) {
-				if(*factory == scheme.c_str()) {
-					return factory->HandlerFactory(url);
-				}
+			auto factory = Factories().front(scheme.c_str());
+			if(factory) {
+				return factory->handler(url);
 			}
 
 			throw runtime_error(Logger::String{"Unable to find url handler for '",scheme.c_str(),"'"});
 		}
 
-		for(const auto factory : factories()) {
-			if(*factory == scheme.c_str()) {
-				return factory->HandlerFactory(*this);
+		{
+			auto factory = Factories().front(scheme.c_str());
+			if(factory) {
+				return factory->handler(*this);
 			}
 		}
 
@@ -111,10 +218,9 @@
 
 					Logger::String{"Module for ",scheme.c_str()," handler loaded"}.trace();
 
-					for(const auto factory : factories()) {
-						if(*factory == scheme.c_str()) {
-							return factory->HandlerFactory(*this);
-						}
+					auto factory = Factories().front(scheme.c_str());
+					if(factory) {
+						return factory->handler(*this);
 					}
 
 				}
@@ -130,10 +236,9 @@
 
 		// Get default handler
 		if(allow_default) {
-			for(const auto factory : factories()) {
-				if(*factory == "default") {
-					return factory->HandlerFactory(*this);
-				}
+			auto factory = Factories().front("default");
+			if(factory) {
+				return factory->handler(*this);
 			}
 		}
 
@@ -143,6 +248,12 @@
 	URL::Handler::~Handler() {
 	}
 
+	bool URL::Handler::reset() {
+		status.code = 0;
+		status.message.clear();
+		return false;
+	}
+
 	URL::Handler & URL::Handler::header(const char *, const char *) {
 		return *this;
 	}
@@ -195,21 +306,16 @@
 	}
 
 	String URL::Handler::get(const HTTP::Method method, const char *payload, const std::function<bool(uint64_t current, uint64_t total)> &progress) {
-		stringstream str;
-		int rc = perform(
-			method, 
-			payload, 
-			[&str,&progress](uint64_t current, uint64_t total, const void *data, size_t len){
-				str.write((const char *) data,len);
-				return progress(current,total);
-			}
-		);
+
+		String str;
+		StringURLSink sink{str,progress};
+
+		int rc = perform(method,payload,sink);
 
 		debug("rc=",rc);
 		except(rc);
-		debug("str=\n",str.str());
 
-		return String{str.str()};
+		return str;
 	}
 
 	String URL::Handler::get(const HTTP::Method method, const char *payload) {
@@ -225,20 +331,8 @@
 			}
 		}
 
-		int rc = perform(
-			method, 
-			payload, 
-			[&file,&progress](uint64_t current, uint64_t total, const void *data, size_t len){
-
-				if(len && data) {
-					file.write(current,data,len);
-				} else if(current == 0 && total) {
-					file.allocate(total);
-				}
-				
-				return progress(current,total);
-			}
-		);
+		FileURLSink sink{file,progress};
+		int rc = perform(method,payload,sink);
 
 		debug("File updated exits with ",rc);
 
@@ -267,23 +361,8 @@
 			}
 		}
 
-		status.code = perform(
-			method, 
-			payload, 
-			[&file,&progress](uint64_t current, uint64_t total, const void *data, size_t len){
-
-				if(len && data) {
-					debug("Writing ",len," bytes");
-					file.write(current,data,len);
-				} else if(current == 0 && total) {
-					debug("Allocating ",total," bytes");
-					file.allocate(total);
-				}
-				
-				debug("Calling progress(",current,",",total,")");
-				return progress(current,total);
-			}
-		);
+		FileURLSink sink{file,progress};
+		status.code = perform(method,payload,sink);
 
 		debug("Update of ",filename," exits with ",status.code);
 		if(status.code == 304) {
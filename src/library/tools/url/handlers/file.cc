@@ -24,6 +24,7 @@
  #include <udjat/tools/logger.h>
  #include <private/url.h>
  #include <stdexcept>
+ #include <vector>
  #include <errno.h>
 
  #ifdef _WIN32
@@ -34,6 +35,12 @@
 	#include <unistd.h>
  #endif // HAVE_UNISTD_H
 
+ #ifndef _WIN32
+	#include <sys/mman.h>
+	#include <sys/sendfile.h>
+	#include <fcntl.h>
+ #endif // _WIN32
+
  using namespace std;
 
  namespace Udjat {
@@ -46,26 +53,117 @@
 		return path.c_str();
 	}
 
-	int FileURLHandler::perform(const HTTP::Method, const char *, const std::function<bool(uint64_t current, uint64_t total, const void *data, size_t len)> &progress) {
+	bool FileURLHandler::reset() {
+		URL::Handler::reset();
+		return true;
+	}
 
-		debug("-----------> FileURLHandler is Loading '",path.c_str(),"'");
+	int FileURLHandler::perform(const HTTP::Method, const char *, Sink &sink) {
 
 		File::Handler file{path.c_str()};
 
-		size_t block_size = file.block_size();
-		char buffer[block_size];
-
 		uint64_t total = file.length();
 		uint64_t current = 0;
 
+		if(total) {
+			sink.allocate(total);
+		}
+
+#ifndef _WIN32
+
+		// Sink with a file descriptor, copy in kernel.
+		int out = sink.descriptor();
+		if(out >= 0 && total) {
+
+			loff_t ioffset = 0;
+			loff_t ooffset = 0;
+
+			while(current < total) {
+
+				ssize_t len = copy_file_range((int) file, &ioffset, out, &ooffset, total - current, 0);
+
+				if(len < 0 && (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP)) {
+
+					// Not supported by the filesystems, try sendfile (writes at the current position).
+					if(lseek(out,ooffset,SEEK_SET) == (off_t) -1) {
+						break;
+					}
+
+					off_t offset = ioffset;
+					len = sendfile(out, (int) file, &offset, total - current);
+					if(len > 0) {
+						ioffset = offset;
+						ooffset += len;
+					}
+				}
+
+				if(len < 0) {
+					if(current) {
+						throw system_error(errno,system_category(),Logger::String{"Error copying '",path.c_str(),"'"});
+					}
+					break;	// Nothing copied, use write().
+				}
+
+				if(!len) {
+					break;
+				}
+
+				current += len;
+
+				if(sink.progress(current,total)) {
+					Logger::String{"Loading of '",path.c_str(),"' was canceled"}.trace();
+					throw system_error(ECANCELED,system_category());
+				}
+
+			}
+
+			if(current) {
+				return 200;
+			}
+
+		}
+
+		// Map the file and send it as a single block.
+		if(total) {
+
+			void *contents = mmap(NULL, total, PROT_READ, MAP_PRIVATE, (int) file, 0);
+			if(contents != MAP_FAILED) {
+
+				madvise(contents, total, MADV_SEQUENTIAL);
+
+				bool canceled = false;
+				try {
+					canceled = sink.write(0,contents,total);
+				} catch(...) {
+					munmap(contents,total);
+					throw;
+				}
+				munmap(contents,total);
+
+				if(canceled) {
+					Logger::String{"Loading of '",path.c_str(),"' was canceled"}.trace();
+					throw system_error(ECANCELED,system_category());
+				}
+
+				return 200;
+			}
+
+		}
+
+#endif // _WIN32
+
+		// On the heap, the block size comes from the filesystem.
+		size_t block_size = file.block_size();
+		std::vector<char> buffer(block_size);
+
 		while(current < total) {
 
-			size_t len = file.read((void *) buffer,block_size,false);
+			size_t len = file.read((void *) buffer.data(),block_size,false);
 			if(!len) {
 				break;
 			}
 
-			if(progress(current,total,buffer,len)) {
+			if(sink.write(current,buffer.data(),len)) {
 				Logger::String{"Loading of '",path.c_str(),"' was canceled"}.trace();
 				throw system_error(ECANCELED,system_category());
 			}
@@ -78,6 +176,34 @@
 
 	}
 
+	int FileURLHandler::perform(const HTTP::Method method, const char *payload, const std::function<bool(uint64_t current, uint64_t total, const void *data, size_t len)> &progress) {
+
+		debug("-----------> FileURLHandler is Loading '",path.c_str(),"'");
+
+		/// @brief Send the blocks to the progress callback.
+		class Writer : public Sink {
+		private:
+			const std::function<bool(uint64_t current, uint64_t total, const void *data, size_t len)> &call;
+			uint64_t total = 0;
+
+		public:
+			Writer(const std::function<bool(uint64_t current, uint64_t total, const void *data, size_t len)> &c) : call{c} {
+			}
+
+			void allocate(uint64_t length) override {
+				total = length;
+			}
+
+			bool write(uint64_t offset, const void *data, size_t length) override {
+				return call(offset,total,data,length);
+			}
+
+		} writer{progress};
+
+		return perform(method,payload,writer);
+
+	}
+
 	int FileURLHandler::test(const HTTP::Method, const char *) {
 
 #ifdef _WIN32
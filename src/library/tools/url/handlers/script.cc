@@ -40,6 +40,11 @@
 		return path.c_str();
 	}
 
+	bool ScriptURLHandler::reset() {
+		URL::Handler::reset();
+		return true;
+	}
+
 	int ScriptURLHandler::perform(const HTTP::Method, const char *, const std::function<bool(uint64_t current, uint64_t total, const void *data, size_t len)> &progress) {
 
 		/// @brief Run script, capture output to lambda.
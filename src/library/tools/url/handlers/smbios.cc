@@ -40,6 +40,12 @@
 		return url.c_str();
 	}
 
+	bool SMBiosURLHandler::reset() {
+		URL::Handler::reset();
+		mimetype = MimeType::json;
+		return true;
+	}
+
 	bool SMBiosURLHandler::get(Udjat::Value &response, const HTTP::Method, const char *) {
 
 		auto elements = url.path(true).split("/");
@@ -0,0 +1,115 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements the URL response sinks.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/url.h>
+ #include <udjat/tools/url/handler.h>
+ #include <udjat/tools/file/handler.h>
+ #include <private/url.h>
+ #include <system_error>
+ #include <cstring>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	URL::Handler::Sink::~Sink() {
+	}
+
+	void URL::Handler::Sink::allocate(uint64_t) {
+	}
+
+	bool URL::Handler::Sink::progress(uint64_t, uint64_t) {
+		return false;
+	}
+
+	int URL::Handler::Sink::descriptor() const noexcept {
+		return -1;
+	}
+
+	bool URL::Handler::BufferSink::write(uint64_t offset, const void *data, size_t length) {
+
+		if(offset > size || length > (size - offset)) {
+			throw system_error(ENOBUFS,system_category(),"The response doesn't fit in the buffer");
+		}
+
+		memcpy(((uint8_t *) buffer)+offset,data,length);
+		if(offset+length > used) {
+			used = offset+length;
+		}
+
+		return false;
+	}
+
+	int URL::Handler::perform(const HTTP::Method method, const char *payload, Sink &sink) {
+		return perform(
+			method,
+			payload,
+			[&sink](uint64_t current, uint64_t total, const void *data, size_t len){
+				if(len && data) {
+					return sink.write(current,data,len);
+				} else if(current == 0 && total) {
+					sink.allocate(total);
+				}
+				return sink.progress(current,total);
+			}
+		);
+	}
+
+	void StringURLSink::allocate(uint64_t length) {
+		total = length;
+		str.reserve(str.size()+length);
+	}
+
+	bool StringURLSink::write(uint64_t offset, const void *data, size_t length) {
+		if(notify(offset,total)) {
+			return true;
+		}
+		str.append((const char *) data,length);
+		return false;
+	}
+
+	bool StringURLSink::progress(uint64_t current, uint64_t length) {
+		return notify(current,length);
+	}
+
+	void FileURLSink::allocate(uint64_t length) {
+		total = length;
+		file.allocate(length);
+	}
+
+	bool FileURLSink::write(uint64_t offset, const void *data, size_t length) {
+		file.write(offset,data,length);
+		return notify(offset,total);
+	}
+
+	bool FileURLSink::progress(uint64_t current, uint64_t length) {
+		return notify(current,length);
+	}
+
+	int FileURLSink::descriptor() const noexcept {
+		return (int) file;
+	}
+
+ }
@@ -29,8 +29,8 @@
  #include <string>
  #include <list>
  #include <memory>
- #include <sstream>
  #include <private/urlparser.h>
+ #include <private/url.h>
  #include <libgen.h>
  #include <udjat/tools/application.h>
  #include <udjat/tools/base64.h>
@@ -50,29 +50,27 @@
  namespace Udjat {
 
 	String URL::servicename() const {
-		
-		ParsedUri uri{*this};
-
-		String result{uri.portText.first, (size_t) (uri.portText.afterLast - uri.portText.first)};
 
-		if(result.empty()) {
+		auto port = components()->port();
+		if(port.empty()) {
 			return scheme();
 		}
 
-		return result;
+		return String{port.data(),port.size()};
 	}
 
 	int URL::port(const char *proto) const {
 
-		#include <udjat/tools/string.h>
-
-		ParsedUri uri{*this};
-		String result{uri.portText.first, (size_t) (uri.portText.afterLast - uri.portText.first)};
+		auto uri = components();
+		String result;
 
-		if(result.empty()) {
-			result = scheme();
-		} else if(result.isnumber()) {
-			return atoi(result.c_str());
+		if(uri->port().empty()) {
+			result.assign(uri->scheme().data(),uri->scheme().size());
+		} else {
+			result.assign(uri->port().data(),uri->port().size());
+			if(result.isnumber()) {
+				return atoi(result.c_str());
+			}
 		}
 
 		struct servent *service = getservbyname(result.c_str(),proto);
@@ -85,10 +83,8 @@
 	}
 
 	String URL::hostname() const {
-		
-		ParsedUri uri{*this};
-		return String{uri.hostText.first, (size_t) (uri.hostText.afterLast - uri.hostText.first)};
-
+		auto hostname = components()->hostname();
+		return String{hostname.data(),hostname.size()};
 	}
 
 	URL & URL::hostname(const char *name) {
@@ -97,37 +93,32 @@
 			throw invalid_argument("Hostname cannot be empty");
 		}
 
-		ParsedUri uri{*this};
+		auto uri = components();
 
 		string newUri;
-		
+
 		// Scheme
-		if (uri.scheme.first) {
-			newUri.append(uri.scheme.first, uri.scheme.afterLast - uri.scheme.first);
+		if (uri->scheme().data()) {
+			newUri.append(uri->scheme());
 			newUri.append("://");
 		}
 
 		// Hostname
 		newUri.append(name);
 
-		if (uri.portText.first) {
+		if (uri->port().data()) {
 			newUri.append(":");
-			newUri.append(uri.portText.first, uri.portText.afterLast - uri.portText.first);
+			newUri.append(uri->port());
 		}
 
 		// Path
-		if (uri.pathHead) {
-			for(UriPathSegmentA *pathSegment = uri.pathHead; pathSegment; pathSegment = pathSegment->next) {
-				newUri += "/";
-				newUri.append(pathSegment->text.first, pathSegment->text.afterLast - pathSegment->text.first);
-			}
-		}
+		newUri.append(uri->path());
 
-		if(uri.query.first) {
+		if(uri->query().data()) {
 			newUri.append("?");
-			newUri.append(uri.query.first, uri.query.afterLast - uri.query.first);
+			newUri.append(uri->query());
 		}
-	
+
 		*this = newUri;
 
 		return *this;
@@ -140,8 +131,8 @@
 			return String{};
 		}
 
-		ParsedUri uri{*this};
-		return String{uri.scheme.first, (size_t) (uri.scheme.afterLast - uri.scheme.first)};
+		auto scheme = components()->scheme();
+		return String{scheme.data(),scheme.size()};
 	}
 
 	static void sanitize(std::string &path) {
@@ -156,18 +147,15 @@
 
 	String URL::path(bool strip) const {
 
-		ParsedUri uri{*this};
+		auto uri = components();
 
 		String result;
 
-		if (uri.pathHead) {
-			for(UriPathSegmentA *pathSegment = uri.pathHead; pathSegment; pathSegment = pathSegment->next) {
-				if(!strip) {
-					result += '/';
-				}
-				size_t len = (size_t) (pathSegment->text.afterLast - pathSegment->text.first);
-				result += string{pathSegment->text.first,len};
+		for(size_t ix = 0; ix < uri->segments(); ix++) {
+			if(!strip) {
+				result += '/';
 			}
+			result += uri->segment(ix);
 		}
 
 		sanitize(result);
@@ -213,33 +201,28 @@
 
 	URL & URL::operator += (const char *path) {
 
-		ParsedUri uri{*this};
+		auto uri = components();
 
 		std::string newUri;
 
 		// Scheme
-		if (uri.scheme.first) {
-			newUri.append(uri.scheme.first, uri.scheme.afterLast - uri.scheme.first);
+		if (uri->scheme().data()) {
+			newUri.append(uri->scheme());
 			newUri.append("://");
 		}
 
 		// Hostname
-		if (uri.hostText.first) {
-			newUri.append(uri.hostText.first, uri.hostText.afterLast - uri.hostText.first);
-		}
+		newUri.append(uri->hostname());
 
-		if (uri.portText.first) {
+		if (uri->port().data()) {
 			newUri.append(":");
-			newUri.append(uri.portText.first, uri.portText.afterLast - uri.portText.first);
+			newUri.append(uri->port());
 		}
 
 		// Path
-		std::list<string> segments;
-		if (uri.pathHead) {
-			for(UriPathSegmentA *pathSegment = uri.pathHead; pathSegment; pathSegment = pathSegment->next) {
-				size_t len =  (size_t) (pathSegment->text.afterLast - pathSegment->text.first);
-				segments.emplace_back(pathSegment->text.first,len);
-			}
+		std::list<std::string_view> segments;
+		for(size_t ix = 0; ix < uri->segments(); ix++) {
+			segments.push_back(uri->segment(ix));
 		}
 
 		const char *ptr = path;
@@ -261,7 +244,7 @@
 		// Concatenate path.
 		{
 			string new_path;
-			for(const string &segment : segments) {
+			for(const auto &segment : segments) {
 				new_path.append("/");
 				new_path.append(segment);
 			}
@@ -280,27 +263,28 @@
 
 		}
 
-		if(uri.query.first) {
+		if(uri->query().data()) {
 			newUri.append("?");
-			newUri.append(uri.query.first, uri.query.afterLast - uri.query.first);
+			newUri.append(uri->query());
 		}
-	
+
 		*this = newUri;
 
 		return *this;
 	}
 
 	bool URL::for_each(const std::function<bool(const char *key, const char *value)> &func) const {
-		ParsedUri uri{*this};
+		auto uri = components();
 		UriQueryListA *queryList = nullptr;
 		int items = 0; 
 		bool rc = false;
 
-		if(!uri.query.first) {
+		auto query = uri->query();
+		if(!query.data()) {
 			return false;
 		}
 
-		if(uriDissectQueryMallocA(&queryList, &items, uri.query.first, uri.query.afterLast) != URI_SUCCESS) {
+		if(uriDissectQueryMallocA(&queryList, &items, query.data(), query.data()+query.size()) != URI_SUCCESS) {
 			throw runtime_error("Unexpected error on uriDissectQueryMallocA");
 		}
 
@@ -333,10 +317,9 @@
 
 		if(!empty()) {
 
-			ParsedUri uri{*this};
-			String scheme{uri.scheme.first, (size_t) (uri.scheme.afterLast - uri.scheme.first)};
+			auto scheme = components()->scheme();
 
-			if(scheme.empty() || strcasecmp(scheme.c_str(),"file") == 0) {
+			if(scheme.empty() || (scheme.size() == 4 && strncasecmp(scheme.data(),"file",4) == 0)) {
 				return true;
 			}
 
@@ -348,32 +331,28 @@
 	bool URL::remote() const {
 
 		if(!empty()) {
-			ParsedUri uri{*this};
-			String scheme{uri.scheme.first, (size_t) (uri.scheme.afterLast - uri.scheme.first)};
-			return !scheme.empty() && strcasecmp(scheme.c_str(),"file") != 0; 
+			auto scheme = components()->scheme();
+			return !scheme.empty() && !(scheme.size() == 4 && strncasecmp(scheme.data(),"file",4) == 0);
 		}
 
 		return false;
 	}
 
 	String URL::call(const HTTP::Method method, const char *payload, const bool console) const {
-		stringstream str;
-		auto hdr = handler();
-		int rc = hdr->perform(
-			method, 
-			payload, 
-			[this,&str,console](uint64_t current, uint64_t total, const void *data, size_t len) -> bool {
-				if(data && len) {
-					str.write((const char *) data,len);
-				}
+		String str;
+		StringURLSink sink{
+			str,
+			[this,console](uint64_t current, uint64_t total) -> bool {
 				if(console) {
 					URL::progress_to_console(this->c_str(),current,total);
 				}
 				return false;
 			}
-		);
+		};
+		auto hdr = handler();
+		int rc = hdr->perform(method,payload,sink);
 		hdr->except(rc);
-		return String{str.str()};		
+		return str;
 	}
 
 	bool URL::get(Udjat::Value &value, const HTTP::Method method, const char *payload) const {
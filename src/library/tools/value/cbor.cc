@@ -0,0 +1,477 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements the CBOR (RFC 8949) serialization of values.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/value.h>
+ #include <udjat/tools/report.h>
+ #include <udjat/tools/timestamp.h>
+ #include <private/cbor.h>
+ #include <system_error>
+ #include <climits>
+ #include <cstring>
+ #include <cmath>
+ #include <string>
+ #include <vector>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	void Value::to_cbor(std::ostream &out) const {
+
+		switch(type) {
+		case Undefined:
+			CBOR::null(out);
+			break;
+
+		case Array:
+			CBOR::head(out,CBOR::Array,size());
+			for_each([&out](const Value &value){
+				value.to_cbor(out);
+				return false;
+			});
+			break;
+
+		case Object:
+			CBOR::head(out,CBOR::Map,size());
+			for_each([&out](const char *name, const Value &value){
+				CBOR::text(out,name);
+				value.to_cbor(out);
+				return false;
+			});
+			break;
+
+		case String:
+			CBOR::text(out,content.ptr ? (const char *) content.ptr : "");
+			break;
+
+		case Icon:
+			CBOR::head(out,CBOR::Tag,CBOR::UdjatTag(Icon));
+			CBOR::text(out,content.ptr ? (const char *) content.ptr : "");
+			break;
+
+		case Url:
+			// Tag 32, URI.
+			CBOR::head(out,CBOR::Tag,32);
+			CBOR::text(out,content.ptr ? (const char *) content.ptr : "");
+			break;
+
+		case Timestamp:
+			// Tag 1, epoch based date/time.
+			CBOR::head(out,CBOR::Tag,1);
+			CBOR::integer(out,(long long) content.timestamp,false);
+			break;
+
+		case Signed:
+			CBOR::integer(out,content.sig,true);
+			break;
+
+		case Unsigned:
+			CBOR::head(out,CBOR::Positive,content.unsig);
+			break;
+
+		case Real:
+			CBOR::real(out,content.dbl);
+			break;
+
+		case Fraction:
+			CBOR::head(out,CBOR::Tag,CBOR::UdjatTag(Fraction));
+			CBOR::real(out,content.dbl);
+			break;
+
+		case Boolean:
+			CBOR::boolean(out,content.sig != 0);
+			break;
+
+		case State:
+			CBOR::head(out,CBOR::Tag,CBOR::UdjatTag(State));
+			CBOR::head(out,CBOR::Positive,content.unsig);
+			break;
+
+		case Report:
+			if(content.ptr) {
+				((const Udjat::Report *) content.ptr)->to_cbor(out);
+			} else {
+				CBOR::null(out);	// No report, decodes back as undefined.
+			}
+			break;
+
+		default:
+			throw logic_error("The value type is unexpected or invalid");
+		}
+
+	}
+
+	/// @brief CBOR decoder.
+	class Value::Decoder {
+	private:
+
+		/// @brief Maximum nesting depth.
+		static constexpr unsigned int max_depth = 128;
+
+		const uint8_t *begin;
+		const uint8_t *ptr;
+		const uint8_t *end;
+
+		[[noreturn]] static void invalid(const char *message) {
+			throw system_error(EINVAL,system_category(),message);
+		}
+
+		inline void require(uint64_t length) const {
+			if(length > (uint64_t) (end-ptr)) {
+				invalid("Truncated CBOR data");
+			}
+		}
+
+		inline uint8_t byte() {
+			require(1);
+			return *(ptr++);
+		}
+
+		uint64_t argument(uint8_t info) {
+
+			if(info < 24) {
+				return info;
+			}
+
+			size_t length;
+			switch(info) {
+			case 24:
+				length = 1;
+				break;
+			case 25:
+				length = 2;
+				break;
+			case 26:
+				length = 4;
+				break;
+			case 27:
+				length = 8;
+				break;
+			default:
+				invalid("Unexpected CBOR argument");
+			}
+
+			require(length);
+
+			uint64_t value = 0;
+			while(length--) {
+				value = (value << 8) | *(ptr++);
+			}
+			return value;
+
+		}
+
+		/// @brief Get text or byte string, including the indefinite length ones.
+		void string(uint8_t major, uint8_t info, std::string &str) {
+
+			if(info != 31) {
+				uint64_t length = argument(info);
+				require(length);
+				str.append((const char *) ptr,(size_t) length);
+				ptr += length;
+				return;
+			}
+
+			// Indefinite length, chunks of the same major type until 'break'.
+			while(true) {
+				uint8_t initial = byte();
+				if(initial == 0xFF) {
+					return;
+				}
+				if((initial >> 5) != major || (initial & 0x1F) == 31) {
+					invalid("Invalid CBOR string chunk");
+				}
+				string(major,initial & 0x1F,str);
+			}
+
+		}
+
+		static double half(uint16_t bits) {
+			int exponent = (bits >> 10) & 0x1F;
+			double mantissa = bits & 0x3FF;
+			double value;
+			if(exponent == 0) {
+				value = ldexp(mantissa, -24);
+			} else if(exponent != 31) {
+				value = ldexp(mantissa + 1024, exponent - 25);
+			} else {
+				value = (mantissa == 0 ? INFINITY : NAN);
+			}
+			return (bits & 0x8000) ? -value : value;
+		}
+
+		/// @brief Check if the next item is the 'break' of an indefinite length container.
+		inline bool next(uint64_t &count) {
+			if(count == UINT64_MAX) {
+				if(byte() == 0xFF) {
+					return false;
+				}
+				ptr--;
+				return true;
+			}
+			return count-- > 0;
+		}
+
+		/// @brief Get number of items, UINT64_MAX for indefinite length.
+		uint64_t items(uint8_t info) {
+			if(info == 31) {
+				return UINT64_MAX;
+			}
+			uint64_t count = argument(info);
+			// Every item has at least one byte.
+			require(count);
+			return count;
+		}
+
+		void report(Value &value, unsigned int depth) {
+
+			Value contents;
+			decode(contents,depth);
+
+			if(contents != Value::Array || contents.size() < 1 || contents[0] != Value::Array) {
+				invalid("Invalid CBOR report");
+			}
+
+			std::vector<std::string> names;
+			contents[0].for_each([&names](const Value &name){
+				names.push_back(name.to_string());
+				return false;
+			});
+
+			Udjat::Report &report = value.ReportFactory(names);
+
+			size_t rows = contents.size();
+			for(size_t row = 1; row < rows; row++) {
+				contents[row].for_each([&report](const Value &cell){
+					report.push_back(cell);
+					return false;
+				});
+			}
+
+		}
+
+		void tag(Value &value, uint64_t tag, unsigned int depth) {
+
+			if(tag == CBOR::UdjatTag(Value::Report)) {
+				report(value,depth);
+				return;
+			}
+
+			if(!(tag == 1 || tag == 32 || tag == CBOR::UdjatTag(Value::Icon) || tag == CBOR::UdjatTag(Value::Signed) || tag == CBOR::UdjatTag(Value::Fraction) || tag == CBOR::UdjatTag(Value::State))) {
+				// Unknown tag, use the tagged item.
+				decode(value,depth);
+				return;
+			}
+
+			Value contents;
+			decode(contents,depth);
+
+			// URLs and icons are tagged strings, the others are tagged numbers.
+			Value::Type type = (Value::Type) contents;
+			if(tag == 32 || tag == CBOR::UdjatTag(Value::Icon)) {
+				if(type != Value::String) {
+					invalid("Unexpected CBOR tag content");
+				}
+			} else if(!(type == Value::Signed || type == Value::Unsigned || type == Value::Real)) {
+				invalid("Unexpected CBOR tag content");
+			}
+
+			if(tag == 1) {
+
+				double timestamp = 0;
+				contents.get(timestamp);
+				if(!(fabs(timestamp) < 1e15)) {
+					invalid("Invalid CBOR timestamp");
+				}
+				value.set(TimeStamp{(time_t) timestamp});
+
+			} else if(tag == 32) {
+
+				value.set(contents.to_string(),Value::Url);
+
+			} else if(tag == CBOR::UdjatTag(Value::Icon)) {
+
+				value.set(contents.to_string(),Value::Icon);
+
+			} else if(tag == CBOR::UdjatTag(Value::Signed)) {
+
+				double number = 0;
+				contents.get(number);
+				if(number > INT_MAX) {
+					value.set(number);
+				} else {
+					value.set((int) number);
+				}
+
+			} else if(tag == CBOR::UdjatTag(Value::Fraction)) {
+
+				value.clear(Value::Fraction);
+				contents.get(value.content.dbl);
+
+			} else {
+
+				value.clear(Value::State);
+				contents.get(value.content.unsig);
+
+			}
+
+		}
+
+	public:
+		Decoder(const void *data, size_t length) : begin{(const uint8_t *) data}, ptr{begin}, end{begin+length} {
+		}
+
+		inline size_t used() const noexcept {
+			return ptr - begin;
+		}
+
+		void decode(Value &value, unsigned int depth = 0) {
+
+			if(++depth > max_depth) {
+				invalid("CBOR data is nested too deeply");
+			}
+
+			uint8_t initial = byte();
+			uint8_t info = initial & 0x1F;
+
+			switch(initial >> 5) {
+			case CBOR::Positive:
+				{
+					uint64_t number = argument(info);
+					if(number <= UINT_MAX) {
+						value.set((unsigned int) number);
+					} else {
+						value.set((double) number);
+					}
+				}
+				break;
+
+			case CBOR::Negative:
+				{
+					uint64_t number = argument(info);
+					if(number <= INT_MAX) {
+						value.set((int) (-1 - (long long) number));
+					} else {
+						value.set(-1.0 - (double) number);
+					}
+				}
+				break;
+
+			case CBOR::Bytes:
+			case CBOR::Text:
+				{
+					std::string str;
+					string(initial >> 5,info,str);
+					if((initial >> 5) == CBOR::Bytes && memchr(str.c_str(),0,str.size())) {
+						invalid("Binary CBOR strings are not supported");
+					}
+					value.set(str,Value::String);
+				}
+				break;
+
+			case CBOR::Array:
+				{
+					value.clear(Value::Array);
+					uint64_t count = items(info);
+					while(next(count)) {
+						decode(value.append(),depth);
+					}
+				}
+				break;
+
+			case CBOR::Map:
+				{
+					value.clear(Value::Object);
+					uint64_t count = items(info);
+					while(next(count)) {
+						Value name;
+						decode(name,depth);
+						if(name != Value::String) {
+							invalid("Unexpected CBOR map key");
+						}
+						decode(value[name.c_str()],depth);
+					}
+				}
+				break;
+
+			case CBOR::Tag:
+				tag(value,argument(info),depth);
+				break;
+
+			default: // CBOR::Simple
+				switch(info) {
+				case 20:
+					value.set(false);
+					break;
+
+				case 21:
+					value.set(true);
+					break;
+
+				case 25:
+					value.set(half((uint16_t) argument(info)));
+					break;
+
+				case 26:
+					{
+						uint32_t bits = (uint32_t) argument(info);
+						float number;
+						memcpy(&number,&bits,sizeof(number));
+						value.set(number);
+					}
+					break;
+
+				case 27:
+					{
+						uint64_t bits = argument(info);
+						double number;
+						memcpy(&number,&bits,sizeof(number));
+						value.set(number);
+					}
+					break;
+
+				case 31:
+					invalid("Unexpected CBOR break");
+
+				default:
+					// null, undefined and the unassigned simple values.
+					if(info == 24) {
+						byte();
+					}
+					value.clear(Value::Undefined);
+				}
+			}
+
+		}
+
+	};
+
+	size_t Value::from_cbor(const void *data, size_t length) {
+		Decoder decoder{data,length};
+		decoder.decode(*this);
+		return decoder.used();
+	}
+
+ }
@@ -533,6 +533,10 @@
 			to_sh(out);
 			break;
 
+		case MimeType::cbor:
+			to_cbor(out);
+			break;
+
 		default:
 			throw runtime_error(Logger::String{"Unable to serialize value to ",std::to_string(mimetype)});
 		}
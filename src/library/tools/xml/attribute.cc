@@ -24,6 +24,7 @@
  #include <udjat/tools/logger.h>
  #include <udjat/tools/intl.h>
  #include <udjat/tools/url.h>
+ #include <private/xml.h>
  #include <cstring>
 
  #ifdef HAVE_VMDETECT
@@ -54,8 +55,9 @@
 		}
 
 		// Search on node children for <attribute name='${attrname}' value= />
-		for(XML::Node child = node.child("attribute"); child; child = child.next_sibling("attribute")) {
-			if(!strcasecmp(child.attribute("name").as_string(""),attrname) && is_allowed(child)) {
+		{
+			XML::Node child{XML::Index::attribute(node,attrname,true)};
+			if(child) {
 				return child.attribute("value");
 			}
 		}
@@ -85,13 +87,9 @@
 				}
 
 				// Search on <attribute> nodes.
-				for(XML::Node child = parent.child("attribute"); child; child = child.next_sibling("attribute")) {
-					
-					if(!strcasecmp(child.attribute("name").as_string(""),key.c_str()) && is_allowed(child)) {
-						return child.attribute("value");
-					}
-
-					if(!strcasecmp(child.attribute("name").as_string(""),attrname) && is_allowed(child)) {
+				{
+					XML::Node child{XML::Index::attribute(parent,key.c_str(),true,attrname)};
+					if(child) {
 						return child.attribute("value");
 					}
 				}
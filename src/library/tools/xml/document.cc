@@ -35,25 +35,26 @@
  #include <stdexcept>
  #include <private/logger.h>
  #include <udjat/module/abstract.h>
- #include <udjat/tools/container.h>
+ #include <private/registry.h>
+ #include <private/xml.h>
 
  using namespace std;
 
  namespace Udjat {
 
-	static Container<XML::Parser> & Factories() {
-		static Container<XML::Parser> instance;
+	static Registry<XML::Parser> & Factories() {
+		static Registry<XML::Parser> instance{"parsers"};
 		return instance;
 	}
 
 	XML::Parser::Parser(const char *n) : parser_name{n} {
 		Logger::String{"Registering parser for <",parser_name,">"}.trace();
-		Factories().push_back(this);
+		Factories().insert(parser_name,this);
 	}
 
 	XML::Parser::~Parser() {
 		Logger::String{"Unregistering parser for <",parser_name,">"}.trace();
-		Factories().remove(this);
+		Factories().remove(parser_name,this);
 	}
 
 	/// @brief Load XML file, check if it's valid.
@@ -77,53 +78,71 @@
 			);
 		}
 
+		// Index only after the document was accepted.
+		XML::Index::insert(*document);
+
  	}
 
 	XML::Document::Document(const char *filename) {
 
 		Udjat::load(this,filename);
 
-		// Preload
-		{
-			auto root = document_element();
-			Logger::setup(root);
-			for(const XML::Node &node : root) {
-				if(node.attribute("preload").as_bool(false)) {
-					Logger::String{"Preloading ",node.name()," '",node.attribute("name").as_string(),"'"}.trace();
-					XML::parse(node);
+		try {
+
+			// Preload
+			{
+				auto root = document_element();
+				Logger::setup(root);
+				for(const XML::Node &node : root) {
+					if(node.attribute("preload").as_bool(false)) {
+						Logger::String{"Preloading ",node.name()," '",node.attribute("name").as_string(),"'"}.trace();
+						XML::parse(node);
+					}
 				}
-			}
 
-		}
+			}
 
-		// Check for update.
-		const XML::Node &node = document_element();
-		URL url{node};
-		url.expand();
+			// Check for update.
+			const XML::Node &node = document_element();
+			URL url{node};
+			url.expand();
 
-		if(!url.empty() && File::outdated(filename,TimeStamp{node,"update-timer"})) {
+			if(!url.empty() && File::outdated(filename,TimeStamp{node,"update-timer"})) {
 
-			try {
+				try {
 				
-				bool updated = url.handler()->set(MimeType::xml).get(filename);
+					bool updated = url.handler()->set(MimeType::xml).get(filename);
 
-				if(updated) {
-					Logger::String{filename," was updated from ",url.c_str()}.info("xml");
-					reset();
-					Udjat::load(this,filename);
-					File::mtime(filename,time(0)); // Mark file as updated.
-				}
+					if(updated) {
+						Logger::String{filename," was updated from ",url.c_str()}.info("xml");
+						XML::Index::remove(*this);
+						reset();
+						Udjat::load(this,filename);
+						File::mtime(filename,time(0)); // Mark file as updated.
+					}
+
+				} catch(const std::exception &e) {
 
-			} catch(const std::exception &e) {
+					Logger::String{"Error updating '",filename,"' from '",url.c_str(),"' - ",e.what()}.warning("xml");
 
-				Logger::String{"Error updating '",filename,"' from '",url.c_str(),"' - ",e.what()}.warning("xml");
+				}
 
 			}
 
+		} catch(...) {
+
+			// The destructor will not run, don't leave the index behind.
+			XML::Index::remove(*this);
+			throw;
+
 		}
 
 	}
 
+	XML::Document::~Document() {
+		XML::Index::remove(*this);
+	}
+
 	time_t XML::Document::parse() const {
 
 		auto root = document_element();
@@ -147,6 +166,7 @@
 		for(auto &child : document_element()) {
 			node.append_copy(child);			
 		}
+		XML::Index::refresh(node);
 		return node;
 	}
 
@@ -171,20 +191,20 @@
 
 		const char *name = node.name();
 	
-		for(const auto factory : Factories()) {
-			if(*factory == name) {
+		for(const auto factory : Factories().find(name)) {
 
-				if(!factory->parse(node)) {
-					continue; // Not handled.
-				}
+			if(!factory->parse(node)) {
+				continue; // Not handled.
+			}
 
-				// Handled, parse children too?
-				if(recursive) {
-					parse_children(node,recursive);
-				}
+			Factories().count(name,factory);
 
-				return true; // Handled.
+			// Handled, parse children too?
+			if(recursive) {
+				parse_children(node,recursive);
 			}
+
+			return true; // Handled.
 		}
 
 		return false; // Not handled.
@@ -0,0 +1,236 @@
+/* SPDX-License-Identifier: LGPL-3.0-or-later */
+
+/*
+ * Copyright (C) 2025 Perry Werneck <perry.werneck@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+ /**
+  * @brief Implements the attribute resolution index for XML documents.
+  */
+
+ #include <config.h>
+ #include <udjat/defs.h>
+ #include <udjat/tools/xml.h>
+ #include <udjat/tools/logger.h>
+ #include <private/xml.h>
+ #include <memory>
+ #include <mutex>
+ #include <shared_mutex>
+ #include <chrono>
+ #include <cstring>
+
+ using namespace std;
+
+ namespace Udjat {
+
+	/// @brief Lookups are much more frequent than loads, don't serialize them.
+	static shared_mutex guard;
+
+	/// @brief Indexed documents, by document node.
+	static unordered_map<XML::Node,shared_ptr<XML::Index>,XML::Index::NodeHash> & Documents() {
+		static unordered_map<XML::Node,shared_ptr<XML::Index>,XML::Index::NodeHash> instance;
+		return instance;
+	}
+
+	/// @brief Get the index for the document containing node.
+	static shared_ptr<XML::Index> IndexFactory(const XML::Node &node) {
+		shared_lock<shared_mutex> lock(guard);
+		auto &documents = Documents();
+		if(documents.empty() || !node) {
+			return shared_ptr<XML::Index>();
+		}
+		auto it = documents.find(node.root());
+		if(it == documents.end()) {
+			return shared_ptr<XML::Index>();
+		}
+		return it->second;
+	}
+
+	XML::Index::Index(const XML::Node &root) {
+
+		auto begin = chrono::steady_clock::now();
+		build(root);
+
+		if(Logger::enabled(Logger::Trace)) {
+			Logger::String{
+				"Indexed ",count," elements on ",scopes.size()," scopes in ",
+				chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - begin).count(),"us"
+			}.trace("xml");
+		}
+
+	}
+
+	void XML::Index::build(const XML::Node &node) {
+
+		size_t position = 0;
+		Scope *scope = nullptr;
+
+		for(XML::Node child = node.first_child(); child; child = child.next_sibling()) {
+
+			if(child.type() != pugi::node_element) {
+				continue;
+			}
+
+			count++;
+
+			if(!scope) {
+				scope = &scopes[node];
+			}
+
+			scope->children[child.name()].push_back(child);
+
+			if(!strcmp(child.name(),"attribute")) {
+				scope->attributes[child.attribute("name").as_string()].push_back(Entry{child,position});
+			}
+
+			position++;
+			build(child);
+
+		}
+
+	}
+
+	const XML::Index::Scope * XML::Index::scope(const XML::Node &node) const noexcept {
+		auto it = scopes.find(node);
+		if(it == scopes.end()) {
+			return nullptr;
+		}
+		return &it->second;
+	}
+
+	void XML::Index::insert(const pugi::xml_document &document) {
+		shared_ptr<Index> index{new Index{document}};
+		unique_lock<shared_mutex> lock(guard);
+		Documents()[document] = index;
+	}
+
+	void XML::Index::remove(const pugi::xml_document &document) noexcept {
+		unique_lock<shared_mutex> lock(guard);
+		Documents().erase(document);
+	}
+
+	void XML::Index::refresh(const XML::Node &node) {
+
+		if(!node) {
+			return;
+		}
+
+		XML::Node root = node.root();
+
+		{
+			shared_lock<shared_mutex> lock(guard);
+			if(Documents().find(root) == Documents().end()) {
+				return;
+			}
+		}
+
+		shared_ptr<Index> index{new Index{root}};
+		unique_lock<shared_mutex> lock(guard);
+		auto it = Documents().find(root);
+		if(it != Documents().end()) {
+			it->second = index;
+		}
+
+	}
+
+	XML::Node XML::Index::attribute(const XML::Node &node, const char *name, bool allowed, const char *alias) {
+
+		auto index = IndexFactory(node);
+
+		if(!index) {
+
+			// Not indexed, scan the node children.
+			for(XML::Node child = node.child("attribute"); child; child = child.next_sibling("attribute")) {
+				const char *attrname = child.attribute("name").as_string();
+				if( (!strcasecmp(attrname,name) || (alias && !strcasecmp(attrname,alias))) && (!allowed || is_allowed(child)) ) {
+					return child;
+				}
+			}
+
+			return XML::Node{};
+		}
+
+		const Scope *scope = index->scope(node);
+		if(!scope) {
+			return XML::Node{};
+		}
+
+		// Get the first allowed node, in document order, matching any of the names.
+		const Entry *selected = nullptr;
+		for(const char *key : { name, alias }) {
+
+			if(!key) {
+				continue;
+			}
+
+			auto it = scope->attributes.find(key);
+			if(it == scope->attributes.end()) {
+				continue;
+			}
+
+			for(const Entry &entry : it->second) {
+				if(selected && entry.position >= selected->position) {
+					break;
+				}
+				if(!allowed || is_allowed(entry.node)) {
+					selected = &entry;
+					break;
+				}
+			}
+
+		}
+
+		return selected ? selected->node : XML::Node{};
+
+	}
+
+	bool XML::Index::for_each(const XML::Node &node, const char *tagname, const std::function<bool(const XML::Node &child)> &call) {
+
+		auto index = IndexFactory(node);
+
+		if(!index) {
+
+			// Not indexed, scan the node children.
+			for(XML::Node child = node.child(tagname); child; child = child.next_sibling(tagname)) {
+				if(call(child)) {
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		const Scope *scope = index->scope(node);
+		if(!scope) {
+			return false;
+		}
+
+		auto it = scope->children.find(tagname);
+		if(it == scope->children.end()) {
+			return false;
+		}
+
+		for(const XML::Node &child : it->second) {
+			if(call(child)) {
+				return true;
+			}
+		}
+
+		return false;
+
+	}
+
+ }
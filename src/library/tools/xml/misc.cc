@@ -27,6 +27,7 @@
  #include <udjat/tools/string.h>
  #include <udjat/tools/url.h>
  #include <udjat/tools/quark.h>
+ #include <private/xml.h>
  #include <iostream>
  #include <cstdarg>
 
@@ -42,10 +43,10 @@
 	bool XML::for_each(const XML::Node &node, const char *attrname, const std::function<bool(const XML::Node &node)> &test) {
 
 		for(XML::Node nd = node; nd; nd = nd.parent()) {
-			for(XML::Node child = nd.child(attrname); child; child = child.next_sibling(attrname)) {
-				if(is_allowed(child) && test(child)) {
-					return true;
-				}
+			if(XML::Index::for_each(nd,attrname,[&test](const XML::Node &child){
+				return is_allowed(child) && test(child);
+			})) {
+				return true;
 			}
 		}
 		return false;
@@ -62,11 +63,9 @@
 			if(attribute)
 				return attribute;
 
-			for(auto child = node.child("attribute"); child; child = child.next_sibling("attribute")) {
-
-				if(strcasecmp(name,child.attribute("name").as_string()) == 0)
-					return child.attribute("value");
-
+			auto child = XML::Index::attribute(node,name,false);
+			if(child) {
+				return child.attribute("value");
 			}
 
 			if(upsearch && node.attribute("allow-upsearch").as_bool(true)) {